@@ -82,7 +82,7 @@ analysis_module_type *analysis_module_alloc(analysis_mode_enum mode) {
             ies::IES_MAX_STEPLENGTH_KEY, ies::IES_MIN_STEPLENGTH_KEY,
             ies::IES_DEC_STEPLENGTH_KEY, ies::IES_INVERSION_KEY,
             ies::IES_LOGFILE_KEY,        ies::IES_DEBUG_KEY,
-            ies::ENKF_TRUNCATION_KEY};
+            ies::ENKF_TRUNCATION_KEY,    ies::IES_A0_ON_DISK_KEY};
         return module;
     } else
         throw std::logic_error("Unhandled enum value");
@@ -160,6 +160,8 @@ static bool analysis_module_set_bool(analysis_module_type *module,
     bool name_recognized = true;
     if (strcmp(var, ies::IES_DEBUG_KEY) == 0)
         logger->warning("The key {} is ignored", ies::IES_DEBUG_KEY);
+    else if (strcmp(var, ies::IES_A0_ON_DISK_KEY) == 0)
+        module->module_config->A0_on_disk = value;
     else
         name_recognized = false;
 
@@ -266,6 +268,9 @@ bool analysis_module_get_bool(const analysis_module_type *module,
     if (strcmp(var, ies::IES_DEBUG_KEY) == 0)
         return false;
 
+    else if (strcmp(var, ies::IES_A0_ON_DISK_KEY) == 0)
+        return module->module_config->A0_on_disk;
+
     util_exit("%s: Tried to get bool variable:%s from module:%s - module "
               "does not support this variable \n",
               __func__, var, module->user_name);
@@ -224,8 +224,7 @@ void ies::updateA(Data &data,
     ies::linalg_store_active_W(data, W0);
 
     /* COMPUTE NEW ENSEMBLE SOLUTION FOR CURRENT ITERATION  Ei=A0*X (Line 11)*/
-    Eigen::MatrixXd A0 = data.make_activeA();
-    A = A0 * X;
+    data.multiply_activeA(X, A);
 }
 
 /**  COMPUTING THE PROJECTION Y= Y * (Ai^+ * Ai) (only used when state_size < ens_size-1)    */
@@ -244,10 +243,16 @@ void ies::linalg_compute_AA_projection(const Eigen::MatrixXd &A,
 * COMPUTE  Omega= I + W (I-11'/sqrt(ens_size))    from Eq. (36).                                   (Line 6)
 *  When solving the system S = Y inv(Omega) we write
 *     Omega^T S^T = Y^T
+*
+*  Omega is a perturbation of the identity; it is solved with a partial pivot
+*  LU factorization. In the first iteration W0 == 0, Omega == I and S == Y.
 */
 Eigen::MatrixXd ies::linalg_solve_S(const Eigen::MatrixXd &W0,
                                     const Eigen::MatrixXd &Y) {
 
+    if (W0.isZero(0))
+        return Y;
+
     /*  Here we compute the W (I-11'/N) / sqrt(N-1)  and transpose it).*/
     Eigen::MatrixXd Omega =
         W0; // Omega=data->W (from previous iteration used to solve for S)
@@ -258,7 +263,7 @@ Eigen::MatrixXd ies::linalg_solve_S(const Eigen::MatrixXd &W0,
     Omega.transposeInPlace();           // Omega=transpose(Omega)
     Omega.diagonal().array() += 1.0;
 
-    Eigen::MatrixXd ST = Omega.fullPivLu().solve(Y.transpose());
+    Eigen::MatrixXd ST = Omega.partialPivLu().solve(Y.transpose());
 
     return ST.transpose();
 }
@@ -320,19 +325,18 @@ void ies::linalg_exact_inversion(Eigen::MatrixXd &W0, const int ies_inversion,
                                  double ies_steplength) {
     int ens_size = S.cols();
 
-    MatrixXd StS = MatrixXd::Identity(ens_size, ens_size) + S.transpose() * S;
-
-    auto svd = StS.bdcSvd(Eigen::ComputeFullU);
-    MatrixXd Z = svd.matrixU();
-    Eigen::VectorXd eig = svd.singularValues();
-
-    MatrixXd ZtStH = Z.transpose() * S.transpose() * H;
+    /*
+     * S'*S + I is symmetric positive definite with all eigenvalues >= 1, so
+     * (b) is solved with a Cholesky factorization; only the lower triangle
+     * of S'*S is computed.
+     */
+    MatrixXd StS = MatrixXd::Identity(ens_size, ens_size);
+    StS.selfadjointView<Eigen::Lower>().rankUpdate(S.transpose());
 
-    for (int i = 0; i < ens_size; i++)
-        ZtStH.row(i) /= eig[i];
+    MatrixXd StS_inv_StH = StS.llt().solve(S.transpose() * H);
 
-    /*    Update data->W = (1-ies_steplength) * data->W +  ies_steplength * Z * (Lamda^{-1}) Z' S' H         (Line 9)    */
-    W0 = ies_steplength * Z * ZtStH + (1.0 - ies_steplength) * W0;
+    /*    Update data->W = (1-ies_steplength) * data->W +  ies_steplength * (S'S + I)^{-1} S' H         (Line 9)    */
+    W0 = ies_steplength * StS_inv_StH + (1.0 - ies_steplength) * W0;
 }
 
 /**
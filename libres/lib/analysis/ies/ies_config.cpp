@@ -85,6 +85,7 @@ RES_LIB_SUBMODULE("ies", m) {
         .def("get_steplength", &ies::Config::get_steplength)
         .def("get_truncation", &ies::Config::get_truncation)
         .def_readwrite("iterable", &ies::Config::iterable)
+        .def_readwrite("A0_on_disk", &ies::Config::A0_on_disk)
         .def_readwrite("inversion", &ies::Config::inversion);
 
     py::enum_<ies::inversion_type>(m, "inversion_type")
@@ -1,5 +1,15 @@
 #include <algorithm>
+#include <future>
 #include <memory>
+#include <stdexcept>
+#include <thread>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <fmt/format.h>
 
 #include <ert/analysis/ies/ies_data.hpp>
 #include <ert/python.hpp>
@@ -22,8 +32,50 @@
   the analysis table.
 */
 
+namespace {
+/**
+  A0 is read from disk and multiplied with X in blocks of at most this many
+  rows, so the memory used by ies::Data::multiply_activeA() is bounded by the
+  block size times the number of workers, and not by the state size.
+*/
+constexpr Eigen::Index ROW_BLOCK_SIZE = 4096;
+
+using RowMajorMatrix =
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+std::vector<Eigen::Index> active_columns(const std::vector<bool> &mask) {
+    std::vector<Eigen::Index> columns;
+    for (size_t iens = 0; iens < mask.size(); iens++)
+        if (mask[iens])
+            columns.push_back(iens);
+    return columns;
+}
+} // namespace
+
 ies::Data::Data(int ens_size) : W(Eigen::MatrixXd::Zero(ens_size, ens_size)) {}
 
+ies::Data::~Data() {
+    if (this->m_A0_fd != -1) {
+        close(this->m_A0_fd);
+        unlink(this->m_A0_file.c_str());
+    }
+}
+
+/**
+  Stores the initial ensemble A0 in the file @path instead of in memory. The
+  file is a scratch file owned by this instance; it is created when A0 is
+  stored and removed again when the instance is destroyed. This must be called
+  before the first update.
+*/
+void ies::Data::set_A0_file(const std::string &path) {
+    if (this->m_A0_stored)
+        throw std::logic_error(
+            "The A0 file must be set before the initial ensemble is stored");
+    this->m_A0_file = path;
+}
+
+bool ies::Data::has_A0_file() const { return !this->m_A0_file.empty(); }
+
 void ies::Data::update_ens_mask(const std::vector<bool> &mask) {
     this->m_ens_mask = mask;
 }
@@ -91,18 +143,85 @@ void ies::Data::augment_initialE(const Eigen::MatrixXd &E0) {
 }
 
 void ies::Data::store_initialA(const Eigen::MatrixXd &A0) {
-    if (this->A0.rows() != 0 || this->A0.cols() != 0)
+    if (this->m_A0_stored)
         return;
-    this->A0 = Eigen::MatrixXd::Zero(A0.rows(), this->m_ens_mask.size());
-    for (int irow = 0; irow < this->A0.rows(); irow++) {
-        int active_idx = 0;
-        for (int iens = 0; iens < this->m_ens_mask.size(); iens++) {
-            if (this->m_ens_mask[iens]) {
-                this->A0(irow, iens) = A0(irow, active_idx);
-                active_idx++;
+
+    this->m_A0_rows = A0.rows();
+    this->m_A0_cols = this->m_ens_mask.size();
+    if (!this->m_A0_file.empty())
+        this->write_A0_file(A0);
+    else {
+        this->A0 = Eigen::MatrixXd::Zero(A0.rows(), this->m_ens_mask.size());
+        for (int irow = 0; irow < this->A0.rows(); irow++) {
+            int active_idx = 0;
+            for (int iens = 0; iens < this->m_ens_mask.size(); iens++) {
+                if (this->m_ens_mask[iens]) {
+                    this->A0(irow, iens) = A0(irow, active_idx);
+                    active_idx++;
+                }
             }
         }
     }
+    this->m_A0_stored = true;
+}
+
+/**
+  Writes A0 to the A0 file one row block at a time, in the same layout as the
+  in memory A0: the rows are stored row major with one column for every
+  realization in the ens_mask, and zeros for the inactive realizations.
+*/
+void ies::Data::write_A0_file(const Eigen::MatrixXd &A0) {
+    this->m_A0_fd =
+        open(this->m_A0_file.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (this->m_A0_fd == -1)
+        throw std::runtime_error(fmt::format("Failed to open {}: {}",
+                                             this->m_A0_file, strerror(errno)));
+
+    const auto columns = active_columns(this->m_ens_mask);
+    RowMajorMatrix block;
+    for (Eigen::Index row_offset = 0; row_offset < this->m_A0_rows;
+         row_offset += ROW_BLOCK_SIZE) {
+        const Eigen::Index block_rows =
+            std::min(ROW_BLOCK_SIZE, this->m_A0_rows - row_offset);
+        block.setZero(block_rows, this->m_A0_cols);
+        for (size_t j = 0; j < columns.size(); j++)
+            block.col(columns[j]) = A0.col(j).segment(row_offset, block_rows);
+
+        const char *data = reinterpret_cast<const char *>(block.data());
+        size_t size = block.size() * sizeof(double);
+        off_t offset = row_offset * this->m_A0_cols * sizeof(double);
+        while (size > 0) {
+            ssize_t written = pwrite(this->m_A0_fd, data, size, offset);
+            if (written == -1 && errno == EINTR)
+                continue;
+            if (written <= 0)
+                throw std::runtime_error(fmt::format(
+                    "Failed to write {}: {}", this->m_A0_file,
+                    written == 0 ? "no space written" : strerror(errno)));
+            data += written;
+            size -= written;
+            offset += written;
+        }
+    }
+}
+
+void ies::Data::read_A0_rows(Eigen::Index row_offset, Eigen::Index num_rows,
+                             double *data) const {
+    char *ptr = reinterpret_cast<char *>(data);
+    size_t size = num_rows * this->m_A0_cols * sizeof(double);
+    off_t offset = row_offset * this->m_A0_cols * sizeof(double);
+    while (size > 0) {
+        ssize_t bytes_read = pread(this->m_A0_fd, ptr, size, offset);
+        if (bytes_read == -1 && errno == EINTR)
+            continue;
+        if (bytes_read <= 0)
+            throw std::runtime_error(fmt::format(
+                "Failed to read {}: {}", this->m_A0_file,
+                bytes_read == 0 ? "unexpected end of file" : strerror(errno)));
+        ptr += bytes_read;
+        size -= bytes_read;
+        offset += bytes_read;
+    }
 }
 
 const std::vector<bool> &ies::Data::obs_mask0() const {
@@ -123,7 +242,14 @@ Eigen::MatrixXd &ies::Data::getW() { return this->W; }
 
 const Eigen::MatrixXd &ies::Data::getW() const { return this->W; }
 
-const Eigen::MatrixXd &ies::Data::getA0() const { return this->A0; }
+Eigen::MatrixXd ies::Data::getA0() const {
+    if (this->m_A0_fd == -1)
+        return this->A0;
+
+    RowMajorMatrix A0(this->m_A0_rows, this->m_A0_cols);
+    this->read_A0_rows(0, this->m_A0_rows, A0.data());
+    return A0;
+}
 
 namespace {
 
@@ -171,12 +297,76 @@ Eigen::MatrixXd ies::Data::make_activeW() const {
 }
 
 Eigen::MatrixXd ies::Data::make_activeA() const {
-    std::vector<bool> row_mask(this->A0.rows(), true);
-    return make_active(this->A0, row_mask, this->m_ens_mask);
+    std::vector<bool> row_mask(this->m_A0_rows, true);
+    return make_active(this->getA0(), row_mask, this->m_ens_mask);
+}
+
+/**
+  Computes A = A0 * X for the active realizations, i.e. the same as
+  make_activeA() * X, without creating the active copy of A0.
+
+  The rows of A are computed in blocks of ROW_BLOCK_SIZE rows by a pool of
+  workers, each taking every num_workers'th block. When A0 is stored on disk
+  each worker reads its row blocks from the A0 file, so the memory used is
+  bounded by the block size and not by the size of A0.
+*/
+void ies::Data::multiply_activeA(const Eigen::MatrixXd &X,
+                                 Eigen::Ref<Eigen::MatrixXd> A) const {
+    const auto columns = active_columns(this->m_ens_mask);
+    if (A.rows() != this->m_A0_rows)
+        throw std::invalid_argument("Size mismatch between A0 and A matrix");
+
+    if (X.rows() != static_cast<Eigen::Index>(columns.size()))
+        throw std::invalid_argument("Size mismatch between A0 and X matrix");
+
+    if (A.cols() != X.cols())
+        throw std::invalid_argument("Size mismatch between X and A matrix");
+
+    const Eigen::Index num_blocks =
+        (this->m_A0_rows + ROW_BLOCK_SIZE - 1) / ROW_BLOCK_SIZE;
+    const int num_workers = std::max<int>(
+        1, std::min<Eigen::Index>(std::thread::hardware_concurrency(),
+                                  num_blocks));
+
+    auto multiply_blocks = [&](int first) {
+        RowMajorMatrix rows;
+        Eigen::MatrixXd active;
+        for (Eigen::Index block = first; block < num_blocks;
+             block += num_workers) {
+            const Eigen::Index row_offset = block * ROW_BLOCK_SIZE;
+            const Eigen::Index block_rows =
+                std::min(ROW_BLOCK_SIZE, this->m_A0_rows - row_offset);
+
+            active.resize(block_rows, columns.size());
+            if (this->m_A0_fd == -1) {
+                for (size_t j = 0; j < columns.size(); j++)
+                    active.col(j) =
+                        this->A0.col(columns[j]).segment(row_offset,
+                                                         block_rows);
+            } else {
+                rows.resize(block_rows, this->m_A0_cols);
+                this->read_A0_rows(row_offset, block_rows, rows.data());
+                for (size_t j = 0; j < columns.size(); j++)
+                    active.col(j) = rows.col(columns[j]);
+            }
+            A.middleRows(row_offset, block_rows).noalias() = active * X;
+        }
+    };
+
+    std::vector<std::future<void>> futures;
+    for (int worker = 1; worker < num_workers; worker++)
+        futures.push_back(
+            std::async(std::launch::async, multiply_blocks, worker));
+    multiply_blocks(0);
+
+    for (auto &fut : futures)
+        fut.get();
 }
 
 RES_LIB_SUBMODULE("ies", m) {
     py::class_<ies::Data, std::shared_ptr<ies::Data>>(m, "ModuleData")
         .def(py::init<int>())
+        .def("set_A0_file", &ies::Data::set_A0_file)
+        .def("has_A0_file", &ies::Data::has_A0_file)
         .def_readwrite("iteration_nr", &ies::Data::iteration_nr);
 }
@@ -1,9 +1,14 @@
 #include <Eigen/Dense>
+#include <algorithm>
 #include <assert.h>
 #include <cerrno>
+#include <cmath>
+#include <cstdint>
 #include <fmt/format.h>
+#include <future>
 #include <optional>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <ert/analysis/analysis_module.hpp>
@@ -32,6 +37,63 @@ bool_vector_to_active_list(const std::vector<bool> &bool_vector) {
     }
     return active_list;
 }
+
+/**
+ Call func(first, stride) on a pool of worker threads, where worker number
+ 'first' is responsible for the items first, first + stride, first + 2*stride,
+ ... below size. The calling thread acts as worker zero.
+
+ When the items are the columns of the A matrix the workers which are running
+ at the same time operate on consecutive realizations; consecutive
+ realizations are stored in different block_fs_driver shards (iens % num_fs),
+ so the workers do not queue up on the same block_fs mutex.
+*/
+template <typename Func> void parallel_for_strided(int size, Func &&func) {
+    const int num_workers =
+        std::max(1, std::min<int>(std::thread::hardware_concurrency(), size));
+
+    std::vector<std::future<void>> futures;
+    for (int worker = 1; worker < num_workers; worker++)
+        futures.push_back(std::async(std::launch::async, [&func, worker,
+                                                          num_workers] {
+            func(worker, num_workers);
+        }));
+    func(0, num_workers);
+
+    for (auto &fut : futures)
+        fut.get();
+}
+
+/**
+ The output function of the SplitMix64 generator. SplitMix64 advances its
+ state by a fixed increment, so the n'th number of the stream started from
+ seed is splitmix64(seed + (n + 1) * SPLITMIX64_GAMMA); this is used as a
+ counter based generator where any element can be computed directly.
+*/
+constexpr uint64_t SPLITMIX64_GAMMA = 0x9E3779B97F4A7C15ULL;
+
+inline uint64_t splitmix64(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/** Uniform number in (0, 1] from the upper 53 bits of x. */
+inline double unit_interval(uint64_t x) {
+    return static_cast<double>((x >> 11) + 1) * 0x1.0p-53;
+}
+
+/**
+ Location of one parameter in the A matrix: the rows
+ [row_offset, row_offset + active_size) hold the active elements of the
+ parameter for all the realizations.
+*/
+struct ParameterBlock {
+    const enkf_config_node_type *config_node;
+    const ActiveList *active_list;
+    int row_offset;
+    int active_size;
+};
 } // namespace
 
 /**
@@ -53,64 +115,154 @@ void ensure_node_loaded(const enkf_config_node_type *config_node,
     }
 }
 
-void serialize_node(enkf_fs_type *fs, const enkf_config_node_type *config_node,
-                    int iens, int row_offset, int column,
-                    const ActiveList *active_list, Eigen::MatrixXd &A) {
-
-    enkf_node_type *node = enkf_node_alloc(config_node);
-    node_id_type node_id = {.report_step = 0, .iens = iens};
-    enkf_node_serialize(node, fs, node_id, active_list, A, row_offset, column);
-    enkf_node_free(node);
-}
-
-void serialize_parameter(const ensemble_config_type *ens_config,
-                         const std::vector<Parameter> &parameters,
-                         enkf_fs_type *target_fs,
-                         const std::vector<int> &iens_active_index,
-                         Eigen::MatrixXd &A) {
-
-    int ens_size = A.cols();
+/**
+ Compute the row layout of the parameters in the A matrix; parameters without
+ any active elements are left out.
+*/
+std::vector<ParameterBlock>
+parameter_layout(const ensemble_config_type *ens_config,
+                 const std::vector<Parameter> &parameters, enkf_fs_type *fs) {
+    std::vector<ParameterBlock> layout;
     int current_row = 0;
 
     for (const auto &parameter : parameters) {
         const enkf_config_node_type *config_node =
             ensemble_config_get_node(ens_config, parameter.name.c_str());
 
-        ensure_node_loaded(config_node, target_fs);
+        ensure_node_loaded(config_node, fs);
         int active_size = parameter.active_list.active_size(
             enkf_config_node_get_data_size(config_node, 0));
 
-        if ((active_size + current_row) > A.rows())
-            A.conservativeResize(A.rows() + 2 * active_size, ens_size);
         if (active_size > 0) {
-            for (int column = 0; column < ens_size; column++) {
-                int iens = iens_active_index[column];
-                serialize_node(target_fs, config_node, iens, current_row,
-                               column, &parameter.active_list, A);
-            }
+            layout.push_back(
+                {config_node, &parameter.active_list, current_row, active_size});
             current_row += active_size;
         }
     }
-    A.conservativeResize(current_row, ens_size);
+    return layout;
+}
+
+/**
+ Serialize the parameters in layout for all the realizations in
+ iens_active_index into A. The realizations are loaded concurrently; each
+ worker fills its own set of columns of A and reuses one enkf_node instance
+ per parameter for all its realizations.
+*/
+Eigen::MatrixXd serialize_layout(const std::vector<ParameterBlock> &layout,
+                                 enkf_fs_type *target_fs,
+                                 const std::vector<int> &iens_active_index) {
+
+    int ens_size = iens_active_index.size();
+    int rows = layout.empty()
+                   ? 0
+                   : layout.back().row_offset + layout.back().active_size;
+
+    Eigen::MatrixXd A = Eigen::MatrixXd::Zero(rows, ens_size);
+    parallel_for_strided(ens_size, [&](int first, int stride) {
+        std::vector<enkf_node_type *> nodes;
+        for (const auto &block : layout)
+            nodes.push_back(enkf_node_alloc(block.config_node));
+
+        for (int column = first; column < ens_size; column += stride) {
+            node_id_type node_id = {.report_step = 0,
+                                    .iens = iens_active_index[column]};
+            for (size_t i = 0; i < layout.size(); i++)
+                enkf_node_serialize(nodes[i], target_fs, node_id,
+                                    layout[i].active_list, A,
+                                    layout[i].row_offset, column);
+        }
+
+        for (auto *node : nodes)
+            enkf_node_free(node);
+    });
+    return A;
+}
+
+/**
+ Whether the existing node must be loaded before deserializing into it. When
+ the active list covers the whole node deserialize overwrites all of it, and
+ the load can be skipped. GEN_DATA nodes get their size from the loaded report
+ step and are always loaded.
+*/
+bool deserialize_needs_load(const ParameterBlock &block) {
+    if (block.active_list->getMode() != ALL_ACTIVE)
+        return true;
+
+    switch (enkf_config_node_get_impl_type(block.config_node)) {
+    case FIELD:
+    case GEN_KW:
+    case SURFACE:
+        return false;
+    default:
+        return true;
+    }
 }
 
-void deserialize_node(enkf_fs_type *target_fs, enkf_fs_type *src_fs,
-                      const enkf_config_node_type *config_node, int iens,
-                      int row_offset, int column, const ActiveList *active_list,
-                      const Eigen::MatrixXd &A) {
+/**
+ Deserialize the columns of the matrices back into the parameter nodes and
+ store them in target_fs; block number i of the layout is taken from
+ *matrices[i].
+
+ The realizations are grouped by the block_fs shard their parameters are
+ stored in, and every worker thread owns a disjoint set of shards, so the
+ writers never contend on the same block_fs. The periodic fsync() is suspended
+ while writing, and one fsync() per shard is issued when all the nodes have
+ been stored.
+*/
+void deserialize_parameters(
+    enkf_fs_type *target_fs, const std::vector<int> &iens_active_index,
+    const std::vector<ParameterBlock> &layout,
+    const std::vector<const Eigen::MatrixXd *> &matrices) {
+
+    if (layout.empty())
+        return;
+
+    int num_shards = enkf_fs_get_parameter_num_shards(target_fs);
+    std::vector<std::vector<int>> shard_columns(num_shards);
+    for (int column = 0; column < iens_active_index.size(); column++) {
+        int iens = iens_active_index[column];
+        shard_columns[enkf_fs_get_parameter_shard(target_fs, iens)].push_back(
+            column);
+    }
 
-    node_id_type node_id = {.report_step = 0, .iens = iens};
-    enkf_node_type *node = enkf_node_alloc(config_node);
+    enkf_fs_suspend_parameter_fsync(target_fs);
+    try {
+        parallel_for_strided(num_shards, [&](int first, int stride) {
+            std::vector<enkf_node_type *> nodes;
+            for (const auto &block : layout)
+                nodes.push_back(enkf_node_alloc(block.config_node));
+
+            for (int shard = first; shard < num_shards; shard += stride) {
+                for (int column : shard_columns[shard]) {
+                    node_id_type node_id = {.report_step = 0,
+                                            .iens = iens_active_index[column]};
+                    for (size_t i = 0; i < layout.size(); i++) {
+                        // If partly active, init node from the fs (deserialize
+                        // will fill it only in part)
+                        if (deserialize_needs_load(layout[i]))
+                            enkf_node_load(nodes[i], target_fs, node_id);
+
+                        // deserialize the matrix into the node (and writes it
+                        // to the target fs)
+                        enkf_node_deserialize(
+                            nodes[i], target_fs, node_id, layout[i].active_list,
+                            *matrices[i], layout[i].row_offset, column);
+                    }
+                }
+            }
 
-    // If partly active, init node from source fs (deserialize will fill it only in part)
-    enkf_node_load(node, src_fs, node_id);
+            for (auto *node : nodes)
+                enkf_node_free(node);
+        });
+    } catch (...) {
+        enkf_fs_resume_parameter_fsync(target_fs);
+        throw;
+    }
+    enkf_fs_resume_parameter_fsync(target_fs);
 
-    // deserialize the matrix into the node (and writes it to the target fs)
-    enkf_node_deserialize(node, target_fs, node_id, active_list, A, row_offset,
-                          column);
-    state_map_update_undefined(enkf_fs_get_state_map(target_fs), iens,
-                               STATE_INITIALIZED);
-    enkf_node_free(node);
+    state_map_type *state_map = enkf_fs_get_state_map(target_fs);
+    for (int iens : iens_active_index)
+        state_map_update_undefined(state_map, iens, STATE_INITIALIZED);
 }
 
 void assert_matrix_size(const Eigen::MatrixXd &m, const char *name, int rows,
@@ -132,15 +284,9 @@ load_parameters(enkf_fs_type *target_fs, ensemble_config_type *ensemble_config,
                 const std::vector<int> &iens_active_index,
                 const std::vector<Parameter> &parameters) {
 
-    int active_ens_size = iens_active_index.size();
     if (!parameters.empty()) {
-        int matrix_start_size = 250000;
-        Eigen::MatrixXd A =
-            Eigen::MatrixXd::Zero(matrix_start_size, active_ens_size);
-
-        serialize_parameter(ensemble_config, parameters, target_fs,
-                            iens_active_index, A);
-        return A;
+        auto layout = parameter_layout(ensemble_config, parameters, target_fs);
+        return serialize_layout(layout, target_fs, iens_active_index);
     }
 
     return {};
@@ -152,23 +298,78 @@ void save_parameters(enkf_fs_type *target_fs,
                      const std::vector<Parameter> &parameters,
                      const Eigen::MatrixXd &A) {
 
-    int ens_size = iens_active_index.size();
-    int current_row = 0;
-    for (auto &parameter : parameters) {
-        const enkf_config_node_type *config_node =
-            ensemble_config_get_node(ensemble_config, parameter.name.c_str());
-        ensure_node_loaded(config_node, target_fs);
-        int active_size = parameter.active_list.active_size(
-            enkf_config_node_get_data_size(config_node, 0));
-        if (active_size > 0) {
-            for (int column = 0; column < ens_size; column++) {
-                int iens = iens_active_index[column];
-                deserialize_node(target_fs, target_fs, config_node, iens,
-                                 current_row, column, &parameter.active_list,
-                                 A);
-            }
-            current_row += active_size;
+    auto layout = parameter_layout(ensemble_config, parameters, target_fs);
+    std::vector<const Eigen::MatrixXd *> matrices(layout.size(), &A);
+
+    deserialize_parameters(target_fs, iens_active_index, layout, matrices);
+}
+
+/**
+ Number of rows the parameters occupy in the A matrix.
+*/
+int parameter_state_size(enkf_fs_type *target_fs,
+                         ensemble_config_type *ensemble_config,
+                         const std::vector<Parameter> &parameters) {
+    auto layout = parameter_layout(ensemble_config, parameters, target_fs);
+    if (layout.empty())
+        return 0;
+    return layout.back().row_offset + layout.back().active_size;
+}
+
+/**
+ Update the parameters in target_fs with A = A * X without assembling the
+ full A matrix.
+
+ The parameters are split in consecutive groups of at most block_size rows;
+ the elements of one parameter are stored together and a parameter is
+ therefore never split, i.e. a parameter larger than block_size forms a group
+ of its own. The groups are processed as a pipeline: while one group is
+ multiplied with X and stored, the next group is loaded by a background task,
+ so at most two groups are held in memory at the same time.
+
+ Observe that this gives the same result as load_parameters(), A * X and
+ save_parameters() only when X does not depend on A, i.e. when the state size
+ is larger than the ensemble size.
+*/
+void update_parameters(enkf_fs_type *target_fs,
+                       ensemble_config_type *ensemble_config,
+                       const std::vector<int> &iens_active_index,
+                       const std::vector<Parameter> &parameters,
+                       const Eigen::MatrixXd &X, int block_size) {
+
+    assert_matrix_size(X, "X", iens_active_index.size(),
+                       iens_active_index.size());
+
+    std::vector<std::vector<ParameterBlock>> groups;
+    int group_rows = 0;
+    for (auto block :
+         parameter_layout(ensemble_config, parameters, target_fs)) {
+        if (groups.empty() || group_rows + block.active_size > block_size) {
+            groups.emplace_back();
+            group_rows = 0;
         }
+        block.row_offset = group_rows;
+        groups.back().push_back(block);
+        group_rows += block.active_size;
+    }
+    if (groups.empty())
+        return;
+
+    auto load_group = [&](size_t index) {
+        return serialize_layout(groups[index], target_fs, iens_active_index);
+    };
+
+    auto next = std::async(std::launch::async, load_group, 0);
+    for (size_t index = 0; index < groups.size(); index++) {
+        Eigen::MatrixXd A = next.get();
+        if (index + 1 < groups.size())
+            next = std::async(std::launch::async, load_group, index + 1);
+
+        A = A * X;
+        std::vector<const Eigen::MatrixXd *> matrices(groups[index].size(),
+                                                      &A);
+        deserialize_parameters(target_fs, iens_active_index, groups[index],
+                               matrices);
     }
 }
 
@@ -182,19 +383,20 @@ void save_row_scaling_parameters(
     const std::vector<std::pair<Eigen::MatrixXd, std::shared_ptr<RowScaling>>>
         &scaled_A) {
     if (scaled_A.size() > 0) {
-        int ikw = 0;
-        for (auto &scaled_parameter : scaled_parameters) {
-            auto &A = scaled_A[ikw].first;
-            for (int column = 0; column < iens_active_index.size(); column++) {
-                int iens = iens_active_index[column];
-                deserialize_node(
-                    target_fs, target_fs,
-                    ensemble_config_get_node(ensemble_config,
-                                             scaled_parameter.name.c_str()),
-                    iens, 0, column, &scaled_parameter.active_list, A);
-            }
-            ikw++;
+        std::vector<ParameterBlock> layout;
+        std::vector<const Eigen::MatrixXd *> matrices;
+        for (int ikw = 0; ikw < scaled_parameters.size(); ikw++) {
+            const auto &scaled_parameter = scaled_parameters[ikw];
+            const auto *config_node = ensemble_config_get_node(
+                ensemble_config, scaled_parameter.name.c_str());
+            int active_size = scaled_parameter.active_list.active_size(
+                enkf_config_node_get_data_size(config_node, 0));
+
+            layout.push_back(
+                {config_node, &scaled_parameter.active_list, 0, active_size});
+            matrices.push_back(&scaled_A[ikw].first);
         }
+        deserialize_parameters(target_fs, iens_active_index, layout, matrices);
     }
 }
 
@@ -211,32 +413,72 @@ load_row_scaling_parameters(
     std::vector<std::pair<Eigen::MatrixXd, std::shared_ptr<RowScaling>>>
         parameters;
     int active_ens_size = iens_active_index.size();
-    if (!config_parameters.empty()) {
-        int matrix_start_size = 250000;
-        Eigen::MatrixXd A = Eigen::MatrixXd::Zero(250000, active_ens_size);
-
-        for (const auto &parameter : config_parameters) {
-            const auto *config_node = ensemble_config_get_node(
-                ensemble_config, parameter.name.c_str());
-            const int node_size =
-                enkf_config_node_get_data_size(config_node, 0);
-            if (A.rows() < node_size)
-                A.conservativeResize(node_size, active_ens_size);
-            for (int column = 0; column < iens_active_index.size(); column++) {
-                int iens = iens_active_index[column];
-                serialize_node(target_fs, config_node, iens, 0, column,
-                               &parameter.active_list, A);
+    for (const auto &parameter : config_parameters) {
+        const auto *config_node =
+            ensemble_config_get_node(ensemble_config, parameter.name.c_str());
+        const int active_size = parameter.active_list.active_size(
+            enkf_config_node_get_data_size(config_node, 0));
+        Eigen::MatrixXd A = Eigen::MatrixXd::Zero(active_size, active_ens_size);
+        parallel_for_strided(active_ens_size, [&](int first, int stride) {
+            enkf_node_type *node = enkf_node_alloc(config_node);
+            for (int column = first; column < active_ens_size;
+                 column += stride) {
+                node_id_type node_id = {.report_step = 0,
+                                        .iens = iens_active_index[column]};
+                enkf_node_serialize(node, target_fs, node_id,
+                                    &parameter.active_list, A, 0, column);
             }
-            auto row_scaling = parameter.row_scaling;
-
-            A.conservativeResize(row_scaling->size(), A.cols());
-            parameters.emplace_back(std::move(A), row_scaling);
-        }
+            enkf_node_free(node);
+        });
+        auto row_scaling = parameter.row_scaling;
+
+        if (A.rows() != row_scaling->size())
+            A.conservativeResizeLike(
+                Eigen::MatrixXd::Zero(row_scaling->size(), A.cols()));
+        parameters.emplace_back(std::move(A), row_scaling);
     }
 
     return parameters;
 }
 
+/**
+ Create a rows x columns matrix of standard normal noise.
+
+ Column j is generated from its own stream of uniform numbers, which start
+ at counter j << 32 of a SplitMix64 generator seeded with seed, and which are
+ turned into normal numbers pairwise with the Box-Muller transform. All the
+ elements are given by seed, row and column alone, so the columns are
+ generated in parallel and the result does not depend on the number of
+ threads; the transform is done with Eigen array operations on one column at
+ a time, so it is vectorized.
+*/
+Eigen::MatrixXd generate_normal_noise(int rows, int columns, uint64_t seed) {
+    Eigen::MatrixXd noise(rows, columns);
+    const Eigen::Index pairs = (rows + 1) / 2;
+
+    parallel_for_strided(columns, [&](int first, int stride) {
+        Eigen::ArrayXd u1(pairs);
+        Eigen::ArrayXd u2(pairs);
+        Eigen::ArrayXd normal(2 * pairs);
+        for (int column = first; column < columns; column += stride) {
+            const uint64_t counter = static_cast<uint64_t>(column) << 32;
+            for (Eigen::Index k = 0; k < pairs; k++) {
+                u1[k] = unit_interval(splitmix64(
+                    seed + (counter + 2 * k + 1) * SPLITMIX64_GAMMA));
+                u2[k] = unit_interval(splitmix64(
+                    seed + (counter + 2 * k + 2) * SPLITMIX64_GAMMA));
+            }
+
+            const Eigen::ArrayXd radius = (-2.0 * u1.log()).sqrt();
+            const Eigen::ArrayXd angle = (2.0 * M_PI) * u2;
+            normal.head(pairs) = radius * angle.cos();
+            normal.tail(pairs) = radius * angle.sin();
+            noise.col(column) = normal.head(rows);
+        }
+    });
+    return noise;
+}
+
 /**
 Copy all parameters from source_fs to target_fs
 */
@@ -335,6 +577,23 @@ static Eigen::MatrixXd generate_noise(int active_obs_size, int active_ens_size,
     return noise;
 }
 
+/**
+ Alternative to generate_noise() where the noise is generated in parallel by
+ generate_normal_noise(); only the seed is drawn from shared_rng. The noise
+ has the same distribution, but not the same values, as generate_noise().
+*/
+static Eigen::MatrixXd generate_noise_parallel(int active_obs_size,
+                                               int active_ens_size,
+                                               py::object shared_rng) {
+    auto shared_rng_ = ert::from_cwrap<rng_type>(shared_rng);
+    uint64_t seed = rng_forward(shared_rng_);
+    seed = (seed << 32) | rng_forward(shared_rng_);
+
+    py::gil_scoped_release release; // see load_row_scaling_parameters_pybind
+    return analysis::generate_normal_noise(active_obs_size, active_ens_size,
+                                           seed);
+}
+
 static void copy_parameters_pybind(py::object source_fs, py::object target_fs,
                                    py::object ensemble_config,
                                    std::vector<bool> ens_mask) {
@@ -371,6 +630,9 @@ load_row_scaling_parameters_pybind(
     auto ensemble_config_ =
         ert::from_cwrap<ensemble_config_type>(ensemble_config);
 
+    // The parameters are loaded by several threads; none of them need
+    // the GIL, so release it while loading.
+    py::gil_scoped_release release;
     return analysis::load_row_scaling_parameters(
         target_fs_, ensemble_config_, iens_active_index, config_parameters);
 }
@@ -384,6 +646,7 @@ load_parameters_pybind(py::object target_fs, py::object ensemble_config,
     auto ensemble_config_ =
         ert::from_cwrap<ensemble_config_type>(ensemble_config);
 
+    py::gil_scoped_release release; // see load_row_scaling_parameters_pybind
     return analysis::load_parameters(target_fs_, ensemble_config_,
                                      iens_active_index, parameters);
 }
@@ -397,9 +660,36 @@ static void save_parameters_pybind(py::object target_fs,
     auto ensemble_config_ =
         ert::from_cwrap<ensemble_config_type>(ensemble_config);
 
+    py::gil_scoped_release release; // see load_row_scaling_parameters_pybind
     analysis::save_parameters(target_fs_, ensemble_config_, iens_active_index,
                               parameters, A);
 }
+
+static int parameter_state_size_pybind(
+    py::object target_fs, py::object ensemble_config,
+    const std::vector<analysis::Parameter> &parameters) {
+    auto target_fs_ = ert::from_cwrap<enkf_fs_type>(target_fs);
+    auto ensemble_config_ =
+        ert::from_cwrap<ensemble_config_type>(ensemble_config);
+
+    return analysis::parameter_state_size(target_fs_, ensemble_config_,
+                                          parameters);
+}
+
+static void
+update_parameters_pybind(py::object target_fs, py::object ensemble_config,
+                         const std::vector<int> &iens_active_index,
+                         const std::vector<analysis::Parameter> &parameters,
+                         const Eigen::MatrixXd &X, int block_size) {
+    auto target_fs_ = ert::from_cwrap<enkf_fs_type>(target_fs);
+    auto ensemble_config_ =
+        ert::from_cwrap<ensemble_config_type>(ensemble_config);
+
+    py::gil_scoped_release release; // see load_row_scaling_parameters_pybind
+    analysis::update_parameters(target_fs_, ensemble_config_,
+                                iens_active_index, parameters, X, block_size);
+}
+
 static void save_row_scaling_parameters_pybind(
     py::object target_fs, py::object ensemble_config,
     std::vector<int> iens_active_index,
@@ -410,6 +700,7 @@ static void save_row_scaling_parameters_pybind(
     auto ensemble_config_ =
         ert::from_cwrap<ensemble_config_type>(ensemble_config);
 
+    py::gil_scoped_release release; // see load_row_scaling_parameters_pybind
     analysis::save_row_scaling_parameters(target_fs_, ensemble_config_,
                                           iens_active_index, config_parameters,
                                           scaled_A);
@@ -464,6 +755,9 @@ RES_LIB_SUBMODULE("update", m) {
     m.def("save_parameters", save_parameters_pybind);
     m.def("save_row_scaling_parameters", save_row_scaling_parameters_pybind);
     m.def("load_parameters", load_parameters_pybind);
+    m.def("parameter_state_size", parameter_state_size_pybind);
+    m.def("update_parameters", update_parameters_pybind);
     m.def("load_row_scaling_parameters", load_row_scaling_parameters_pybind);
     m.def("generate_noise", generate_noise);
+    m.def("generate_noise_parallel", generate_noise_parallel);
 }
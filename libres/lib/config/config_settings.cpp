@@ -102,6 +102,20 @@ static double setting_node_get_double_value(const setting_node_type *node) {
     return strtod(node->string_value, NULL);
 }
 
+static void setting_node_set_int_value(setting_node_type *node, int value) {
+    setting_node_assert_type(node, CONFIG_INT);
+    {
+        char *string_value = (char *)util_alloc_sprintf("%d", value);
+        setting_node_set_value(node, string_value);
+        free(string_value);
+    }
+}
+
+static int setting_node_get_int_value(const setting_node_type *node) {
+    setting_node_assert_type(node, CONFIG_INT);
+    return strtol(node->string_value, NULL, 10);
+}
+
 config_settings_type *config_settings_alloc(const char *root_key) {
     config_settings_type *settings =
         (config_settings_type *)util_malloc(sizeof *settings);
@@ -136,6 +150,13 @@ void config_settings_add_double_setting(config_settings_type *settings,
     free(string_value);
 }
 
+void config_settings_add_int_setting(config_settings_type *settings,
+                                     const char *key, int initial_value) {
+    char *string_value = (char *)util_alloc_sprintf("%d", initial_value);
+    config_settings_add_setting(settings, key, CONFIG_INT, string_value);
+    free(string_value);
+}
+
 bool config_settings_has_key(const config_settings_type *settings,
                              const char *key) {
     return hash_has_key(settings->settings, key);
@@ -154,6 +175,12 @@ config_settings_get_double_value(const config_settings_type *config_settings,
     return setting_node_get_double_value(node);
 }
 
+int config_settings_get_int_value(const config_settings_type *config_settings,
+                                  const char *key) {
+    setting_node_type *node = config_settings_get_node(config_settings, key);
+    return setting_node_get_int_value(node);
+}
+
 bool config_settings_set_value(const config_settings_type *config_settings,
                                const char *key, const char *value) {
     if (config_settings_has_key(config_settings, key)) {
@@ -178,6 +205,18 @@ bool config_settings_set_double_value(
     return false;
 }
 
+bool config_settings_set_int_value(const config_settings_type *config_settings,
+                                   const char *key, int value) {
+    if (config_settings_has_key(config_settings, key)) {
+        setting_node_type *node =
+            config_settings_get_node(config_settings, key);
+        setting_node_set_int_value(node, value);
+        return true;
+    }
+
+    return false;
+}
+
 void config_settings_init_parser__(const char *root_key,
                                    config_parser_type *config, bool required) {
     config_schema_item_type *item =
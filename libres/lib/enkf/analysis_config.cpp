@@ -41,6 +41,7 @@
 
 #define UPDATE_ENKF_ALPHA_KEY "ENKF_ALPHA"
 #define UPDATE_STD_CUTOFF_KEY "STD_CUTOFF"
+#define UPDATE_BLOCK_SIZE_KEY "UPDATE_BLOCK_SIZE"
 
 #define ANALYSIS_CONFIG_TYPE_ID 64431306
 
@@ -179,6 +180,18 @@ double analysis_config_get_std_cutoff(const analysis_config_type *config) {
     return config_settings_get_double_value(config->update_settings,
                                             UPDATE_STD_CUTOFF_KEY);
 }
+
+void analysis_config_set_update_block_size(analysis_config_type *config,
+                                           int block_size) {
+    config_settings_set_int_value(config->update_settings,
+                                  UPDATE_BLOCK_SIZE_KEY, block_size);
+}
+
+int analysis_config_get_update_block_size(const analysis_config_type *config) {
+    return config_settings_get_int_value(config->update_settings,
+                                         UPDATE_BLOCK_SIZE_KEY);
+}
+
 void analysis_config_set_log_path(analysis_config_type *config,
                                   const char *log_path) {
     config->log_path = util_realloc_string_copy(config->log_path, log_path);
@@ -478,6 +491,9 @@ analysis_config_type *analysis_config_alloc_full(
                                        UPDATE_ENKF_ALPHA_KEY, alpha);
     config_settings_add_double_setting(config->update_settings,
                                        UPDATE_STD_CUTOFF_KEY, std_cutoff);
+    config_settings_add_int_setting(config->update_settings,
+                                    UPDATE_BLOCK_SIZE_KEY,
+                                    DEFAULT_UPDATE_BLOCK_SIZE);
 
     config->rerun = rerun;
     config->rerun_start = rerun_start;
@@ -506,6 +522,9 @@ analysis_config_type *analysis_config_alloc_default(void) {
     config_settings_add_double_setting(config->update_settings,
                                        UPDATE_STD_CUTOFF_KEY,
                                        DEFAULT_ENKF_STD_CUTOFF);
+    config_settings_add_int_setting(config->update_settings,
+                                    UPDATE_BLOCK_SIZE_KEY,
+                                    DEFAULT_UPDATE_BLOCK_SIZE);
 
     analysis_config_set_rerun(config, DEFAULT_RERUN);
     analysis_config_set_rerun_start(config, DEFAULT_RERUN_START);
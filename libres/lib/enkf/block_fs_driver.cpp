@@ -38,6 +38,7 @@ typedef struct bfs_struct bfs_type;
 typedef struct bfs_config_struct bfs_config_type;
 
 struct bfs_config_struct {
+    bfs_durability_enum durability;
     int fsync_interval;
     bool read_only;
     int block_size;
@@ -54,18 +55,22 @@ struct bfs_struct {
     const bfs_config_type *config;
 };
 
-bfs_config_type *bfs_config_alloc(bool read_only) {
-    const int fsync_interval =
-        10; /* An fsync() call is issued for every 10'th write. */
+static void bfs_config_set_durability(bfs_config_type *config,
+                                      bfs_durability_enum durability) {
+    config->durability = durability;
+    if (durability == BFS_DURABILITY_WRITE)
+        config->fsync_interval =
+            10; /* An fsync() call is issued for every 10'th write. */
+    else
+        config->fsync_interval = 0;
+}
 
-    {
-        bfs_config_type *config =
-            (bfs_config_type *)util_malloc(sizeof *config);
-        config->fsync_interval = fsync_interval;
-        config->read_only = read_only;
-        config->block_size = 64;
-        return config;
-    }
+bfs_config_type *bfs_config_alloc(bool read_only) {
+    bfs_config_type *config = (bfs_config_type *)util_malloc(sizeof *config);
+    bfs_config_set_durability(config, BFS_DURABILITY_WRITE);
+    config->read_only = read_only;
+    config->block_size = 64;
+    return config;
 }
 
 void bfs_config_free(bfs_config_type *config) { free(config); }
@@ -130,6 +135,17 @@ void ert::block_fs_driver::load_node(const char *node_key, int report_step,
     free(key);
 }
 
+void ert::block_fs_driver::load_node_range(const char *node_key,
+                                           int report_step, int iens,
+                                           size_t offset, size_t size,
+                                           void *ptr) {
+    char *key = block_fs_driver_alloc_node_key(node_key, report_step, iens);
+    bfs_type *bfs = this->get_fs(iens);
+
+    block_fs_fread_range(bfs->block_fs, key, offset, size, ptr);
+    free(key);
+}
+
 void ert::block_fs_driver::load_vector(const char *node_key, int iens,
                                        buffer_type *buffer) {
     char *key = block_fs_driver_alloc_vector_key(node_key, iens);
@@ -139,6 +155,46 @@ void ert::block_fs_driver::load_vector(const char *node_key, int iens,
     free(key);
 }
 
+void ert::block_fs_driver::load_vector_range(const char *node_key, int iens,
+                                             size_t offset, size_t size,
+                                             void *ptr) {
+    char *key = block_fs_driver_alloc_vector_key(node_key, iens);
+    bfs_type *bfs = this->get_fs(iens);
+
+    block_fs_fread_range(bfs->block_fs, key, offset, size, ptr);
+    free(key);
+}
+
+/**
+  Returns a buffer which wraps the stored node in the memory mapped data
+  file, i.e. the content is not copied. The buffer must be released with
+  buffer_free_container(). Returns NULL if the data file could not be memory
+  mapped; the node must then be read with load_node().
+*/
+static buffer_type *bfs_alloc_view(bfs_type *bfs, const char *key) {
+    const void *data;
+    size_t size;
+    if (block_fs_fread_view(bfs->block_fs, key, &data, &size))
+        return buffer_alloc_private_wrapper(const_cast<void *>(data), size);
+    return NULL;
+}
+
+buffer_type *ert::block_fs_driver::alloc_node_view(const char *node_key,
+                                                   int report_step, int iens) {
+    char *key = block_fs_driver_alloc_node_key(node_key, report_step, iens);
+    buffer_type *buffer = bfs_alloc_view(this->get_fs(iens), key);
+    free(key);
+    return buffer;
+}
+
+buffer_type *ert::block_fs_driver::alloc_vector_view(const char *node_key,
+                                                     int iens) {
+    char *key = block_fs_driver_alloc_vector_key(node_key, iens);
+    buffer_type *buffer = bfs_alloc_view(this->get_fs(iens), key);
+    free(key);
+    return buffer;
+}
+
 void ert::block_fs_driver::save_node(const char *node_key, int report_step,
                                      int iens, buffer_type *buffer) {
     char *key = block_fs_driver_alloc_node_key(node_key, report_step, iens);
@@ -155,6 +211,41 @@ void ert::block_fs_driver::save_vector(const char *node_key, int iens,
     free(key);
 }
 
+static void bfs_batch_append(std::vector<block_fs_batch_node> &nodes,
+                             char *key, const buffer_type *buffer) {
+    const char *data = (const char *)buffer_get_data(buffer);
+    nodes.push_back(
+        {key, std::vector<char>(data, data + buffer_get_size(buffer))});
+    free(key);
+}
+
+void ert::block_fs_driver::save_node(write_batch &batch, const char *node_key,
+                                     int report_step, int iens,
+                                     const buffer_type *buffer) {
+    bfs_batch_append(
+        batch.shards[this->get_shard(iens)],
+        block_fs_driver_alloc_node_key(node_key, report_step, iens), buffer);
+}
+
+void ert::block_fs_driver::save_vector(write_batch &batch,
+                                       const char *node_key, int iens,
+                                       const buffer_type *buffer) {
+    bfs_batch_append(batch.shards[this->get_shard(iens)],
+                     block_fs_driver_alloc_vector_key(node_key, iens), buffer);
+}
+
+/**
+  Writes the nodes in the batch with one write per shard, followed by one
+  fsync() per shard unless the durability is BFS_DURABILITY_UMOUNT. The
+  batch is empty afterwards and can be reused.
+*/
+void ert::block_fs_driver::commit(write_batch &batch) {
+    const bool sync = this->config->durability != BFS_DURABILITY_UMOUNT;
+    for (const auto &[shard, nodes] : batch.shards)
+        block_fs_fwrite_batch(this->fs_list[shard]->block_fs, nodes, sync);
+    batch.shards.clear();
+}
+
 bool ert::block_fs_driver::has_node(const char *node_key, int report_step,
                                     int iens) {
     char *key = block_fs_driver_alloc_node_key(node_key, report_step, iens);
@@ -197,6 +288,63 @@ void ert::block_fs_driver::fsync() {
         bfs_fsync(this->fs_list[driver_nr]);
 }
 
+/**
+  Stop the periodic fsync() calls in all the shards, e.g. while writing back
+  all the parameters after an update. Must be paired with resume_fsync(),
+  which will issue one fsync() per shard unless the durability is
+  BFS_DURABILITY_UMOUNT.
+*/
+void ert::block_fs_driver::suspend_fsync() {
+    for (int driver_nr = 0; driver_nr < this->num_fs; driver_nr++)
+        block_fs_set_fsync_interval(this->fs_list[driver_nr]->block_fs, 0);
+}
+
+void ert::block_fs_driver::resume_fsync() {
+    const bool sync = this->config->durability != BFS_DURABILITY_UMOUNT;
+    for (int driver_nr = 0; driver_nr < this->num_fs; driver_nr++) {
+        bfs_type *bfs = this->fs_list[driver_nr];
+        block_fs_set_fsync_interval(bfs->block_fs,
+                                    bfs->config->fsync_interval);
+        if (sync)
+            bfs_fsync(bfs);
+    }
+}
+
+void ert::block_fs_driver::set_durability(bfs_durability_enum durability) {
+    bfs_config_set_durability(this->config, durability);
+    for (int driver_nr = 0; driver_nr < this->num_fs; driver_nr++)
+        block_fs_set_fsync_interval(this->fs_list[driver_nr]->block_fs,
+                                    this->config->fsync_interval);
+}
+
+/**
+  Returns the total number of fsync() calls on the data files of all the
+  shards since they were mounted.
+*/
+int ert::block_fs_driver::get_fsync_count() const {
+    int fsync_count = 0;
+    for (int driver_nr = 0; driver_nr < this->num_fs; driver_nr++)
+        fsync_count +=
+            block_fs_get_fsync_count(this->fs_list[driver_nr]->block_fs);
+    return fsync_count;
+}
+
+/**
+  Compacts the data files of all the shards, see block_fs_compact(). Returns
+  the total number of bytes reclaimed.
+*/
+long ert::block_fs_driver::compact() {
+    std::vector<std::future<long>> futures;
+    for (int driver_nr = 0; driver_nr < this->num_fs; ++driver_nr)
+        futures.push_back(std::async(std::launch::async, block_fs_compact,
+                                     this->fs_list[driver_nr]->block_fs));
+
+    long reclaimed = 0;
+    for (auto &fut : futures)
+        reclaimed += fut.get();
+    return reclaimed;
+}
+
 ert::block_fs_driver::block_fs_driver(int num_fs) : num_fs(num_fs) {
     this->fs_list = (bfs_type **)util_calloc(this->num_fs, sizeof(bfs_type *));
 }
@@ -282,6 +282,22 @@ double block_obs_iget_data(const block_obs_type *block_obs, const void *state,
     return point_obs_iget_data(point_obs, state, iobs, node_id);
 }
 
+/**
+   The active indices of the field cells which are observed, or an empty
+   vector if the observations are of summary data.
+*/
+std::vector<int> block_obs_get_active_cells(const block_obs_type *block_obs) {
+    std::vector<int> active_cells;
+    for (int iobs = 0; iobs < block_obs_get_size(block_obs); iobs++) {
+        const point_obs_type *point_obs =
+            block_obs_iget_point_const(block_obs, iobs);
+        if (point_obs->source_type != SOURCE_FIELD)
+            return {};
+        active_cells.push_back(point_obs->active_index);
+    }
+    return active_cells;
+}
+
 void block_obs_measure(const block_obs_type *block_obs, const void *state,
                        node_id_type node_id, meas_data_type *meas_data) {
     block_obs_assert_data(block_obs, state);
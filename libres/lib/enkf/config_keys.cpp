@@ -13,6 +13,7 @@ RES_LIB_SUBMODULE("config_keys", m) {
     cls.attr("ANALYSIS_SET_VAR") = ANALYSIS_SET_VAR_KEY;
     cls.attr("ARGLIST") = "ARGLIST";
     cls.attr("BASE_SURFACE_KEY") = BASE_SURFACE_KEY;
+    cls.attr("COMPRESSION") = COMPRESSION_KEY;
     cls.attr("CONFIG_DIRECTORY") = CONFIG_DIRECTORY_KEY;
     cls.attr("CONFIG_FILE_KEY") = RES_CONFIG_FILE_KEY;
     cls.attr("CONTAINER_KEY") = CONTAINER_KEY;
@@ -103,6 +104,7 @@ RES_LIB_SUBMODULE("config_keys", m) {
     // raw command line arguments to executable.
     // It is heavily used in Everest as the Everest configuration transpiles all jobs
     // into SIMULATION_JOB.
+    cls.attr("SHUFFLE") = SHUFFLE_KEY;
     cls.attr("SIMULATION_JOB") = SIMULATION_JOB_KEY;
     cls.attr("SINGLE_NODE_UPDATE") = SINGLE_NODE_UPDATE_KEY;
     cls.attr("SLURM_EXCLUDE_HOST_OPTION") = SLURM_EXCLUDE_HOST_OPTION;
@@ -119,6 +121,7 @@ RES_LIB_SUBMODULE("config_keys", m) {
     cls.attr("SRC_NAME") = "SRC_NAME";
     cls.attr("STD_CUTOFF_KEY") = STD_CUTOFF_KEY;
     cls.attr("STOP_LONG_RUNNING") = STOP_LONG_RUNNING_KEY;
+    cls.attr("STORAGE_DURABILITY") = STORAGE_DURABILITY_KEY;
     cls.attr("SUMMARY") = SUMMARY_KEY;
     cls.attr("SURFACE_KEY") = SURFACE_KEY;
     cls.attr("TEMPLATE") = TEMPLATE_KEY;
@@ -18,7 +18,9 @@
 
 #include <filesystem>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <fcntl.h>
@@ -40,6 +42,8 @@
 #include <ert/enkf/enkf_defaults.hpp>
 #include <ert/enkf/enkf_fs.hpp>
 #include <ert/enkf/misfit_ensemble.hpp>
+#include <ert/enkf/summary.hpp>
+#include <ert/enkf/summary_table.hpp>
 
 #include <fmt/format.h>
 
@@ -137,6 +141,7 @@ static auto logger = ert::get_logger("enkf");
 #define STATE_MAP_FILE "state-map"
 #define MISFIT_ENSEMBLE_FILE "misfit-ensemble"
 #define CASE_CONFIG_FILE "case_config"
+#define SUMMARY_TABLE_KEY "__SUMMARY_TABLE__"
 
 struct enkf_fs_struct {
     UTIL_TYPE_ID_DECLARATION;
@@ -166,12 +171,30 @@ struct enkf_fs_struct {
     path_fmt_type *case_tstep_fmt;
     path_fmt_type *case_tstep_member_fmt;
 
+    /** The key directories of the summary tables which have been read or
+     * written, by iens; NULL if the realization does not have a table. */
+    std::unordered_map<int,
+                       std::shared_ptr<const ert::summary_table::directory>>
+        summary_directories;
+    std::mutex summary_mutex;
+
     int refcount;
     /** Counts the number of simulations currently writing to this enkf_fs; the
      * purpose is to be able to answer the question: Is this case currently 'running'? */
     int runcount;
 };
 
+/**
+  Nodes which are written to storage together by enkf_fs_batch_commit(), see
+  ert::block_fs_driver::write_batch.
+*/
+struct enkf_fs_batch_struct {
+    enkf_fs_type *fs;
+    std::unordered_map<ert::block_fs_driver *,
+                       ert::block_fs_driver::write_batch>
+        drivers;
+};
+
 UTIL_SAFE_CAST_FUNCTION(enkf_fs, ENKF_FS_TYPE_ID)
 UTIL_IS_INSTANCE_FUNCTION(enkf_fs, ENKF_FS_TYPE_ID)
 
@@ -574,6 +597,27 @@ void enkf_fs_fsync(enkf_fs_type *fs) {
     enkf_fs_fsync_summary_key_set(fs);
 }
 
+/**
+  The parameters of realization iens are stored in block_fs shard number
+  enkf_fs_get_parameter_shard(fs, iens); writes to different shards do not
+  contend on the same lock or the same file.
+*/
+int enkf_fs_get_parameter_num_shards(const enkf_fs_type *fs) {
+    return fs->parameter->get_num_fs();
+}
+
+int enkf_fs_get_parameter_shard(const enkf_fs_type *fs, int iens) {
+    return fs->parameter->get_shard(iens);
+}
+
+void enkf_fs_suspend_parameter_fsync(enkf_fs_type *fs) {
+    fs->parameter->suspend_fsync();
+}
+
+void enkf_fs_resume_parameter_fsync(enkf_fs_type *fs) {
+    fs->parameter->resume_fsync();
+}
+
 void enkf_fs_fread_node(enkf_fs_type *enkf_fs, buffer_type *buffer,
                         const char *node_key, enkf_var_type var_type,
                         int report_step, int iens) {
@@ -589,6 +633,23 @@ void enkf_fs_fread_node(enkf_fs_type *enkf_fs, buffer_type *buffer,
     driver->load_node(node_key, report_step, iens, buffer);
 }
 
+/**
+  Reads size bytes from offset in the stored node; throws std::out_of_range
+  if the node is shorter than offset + size.
+*/
+void enkf_fs_fread_node_range(enkf_fs_type *enkf_fs, const char *node_key,
+                              enkf_var_type var_type, int report_step,
+                              int iens, size_t offset, size_t size,
+                              void *ptr) {
+    ert::block_fs_driver *driver =
+        enkf_fs_select_driver(enkf_fs, var_type, node_key);
+    if (var_type == PARAMETER)
+        /* Parameters are *ONLY* stored at report_step == 0 */
+        report_step = 0;
+
+    driver->load_node_range(node_key, report_step, iens, offset, size, ptr);
+}
+
 void enkf_fs_fread_vector(enkf_fs_type *enkf_fs, buffer_type *buffer,
                           const char *node_key, enkf_var_type var_type,
                           int iens) {
@@ -601,6 +662,33 @@ void enkf_fs_fread_vector(enkf_fs_type *enkf_fs, buffer_type *buffer,
     driver->load_vector(node_key, iens, buffer);
 }
 
+/**
+  Zero-copy variants of enkf_fs_fread_node() and enkf_fs_fread_vector(): the
+  returned buffer wraps the data directly in the storage, and must be released
+  with buffer_free_container(). NULL is returned when the storage does not
+  support this, i.e. when the data file could not be memory mapped.
+*/
+buffer_type *enkf_fs_alloc_node_view(enkf_fs_type *enkf_fs,
+                                     const char *node_key,
+                                     enkf_var_type var_type, int report_step,
+                                     int iens) {
+    ert::block_fs_driver *driver =
+        enkf_fs_select_driver(enkf_fs, var_type, node_key);
+    if (var_type == PARAMETER)
+        /* Parameters are *ONLY* stored at report_step == 0 */
+        report_step = 0;
+
+    return driver->alloc_node_view(node_key, report_step, iens);
+}
+
+buffer_type *enkf_fs_alloc_vector_view(enkf_fs_type *enkf_fs,
+                                       const char *node_key,
+                                       enkf_var_type var_type, int iens) {
+    ert::block_fs_driver *driver =
+        enkf_fs_select_driver(enkf_fs, var_type, node_key);
+    return driver->alloc_vector_view(node_key, iens);
+}
+
 bool enkf_fs_has_node(enkf_fs_type *enkf_fs, const char *node_key,
                       enkf_var_type var_type, int report_step, int iens) {
     ert::block_fs_driver *driver =
@@ -608,11 +696,164 @@ bool enkf_fs_has_node(enkf_fs_type *enkf_fs, const char *node_key,
     return driver->has_node(node_key, report_step, iens);
 }
 
+static std::shared_ptr<const ert::summary_table::directory>
+enkf_fs_get_summary_directory(enkf_fs_type *fs, int iens);
+
 bool enkf_fs_has_vector(enkf_fs_type *enkf_fs, const char *node_key,
                         enkf_var_type var_type, int iens) {
     ert::block_fs_driver *driver =
         enkf_fs_select_driver(enkf_fs, var_type, node_key);
-    return driver->has_vector(node_key, iens);
+    if (driver->has_vector(node_key, iens))
+        return true;
+
+    // The summary vectors are stored in the summary table of the realization.
+    if (var_type == DYNAMIC_RESULT) {
+        auto dir = enkf_fs_get_summary_directory(enkf_fs, iens);
+        return dir && dir->columns.count(node_key) > 0;
+    }
+    return false;
+}
+
+/**
+  Returns the key directory of the summary table of realization iens, or
+  NULL if the realization does not have a summary table. Only the header
+  and the directory are read from storage, and the result is cached.
+*/
+static std::shared_ptr<const ert::summary_table::directory>
+enkf_fs_get_summary_directory(enkf_fs_type *fs, int iens) {
+    {
+        std::lock_guard guard{fs->summary_mutex};
+        auto iter = fs->summary_directories.find(iens);
+        if (iter != fs->summary_directories.end())
+            return iter->second;
+    }
+
+    std::shared_ptr<const ert::summary_table::directory> dir;
+    if (fs->dynamic_forecast->has_vector(SUMMARY_TABLE_KEY, iens)) {
+        char header[ert::summary_table::header_size];
+        fs->dynamic_forecast->load_vector_range(SUMMARY_TABLE_KEY, iens, 0,
+                                                sizeof header, header);
+
+        std::vector<char> directory_data(
+            ert::summary_table::fread_directory_size(header));
+        fs->dynamic_forecast->load_vector_range(
+            SUMMARY_TABLE_KEY, iens, sizeof header, directory_data.size(),
+            directory_data.data());
+        dir = std::make_shared<const ert::summary_table::directory>(
+            ert::summary_table::fread_directory(header,
+                                                directory_data.data()));
+    }
+
+    // A table written by another thread in the meantime takes precedence.
+    std::lock_guard guard{fs->summary_mutex};
+    return fs->summary_directories.emplace(iens, dir).first->second;
+}
+
+/**
+  Reads the vector of one summary key from the summary table of realization
+  iens, without reading the rest of the table. Returns false if the
+  realization does not have a summary table, or the table does not contain
+  the key.
+*/
+bool enkf_fs_fread_summary_vector(enkf_fs_type *fs, const char *key, int iens,
+                                  std::vector<double> &data) {
+    auto dir = enkf_fs_get_summary_directory(fs, iens);
+    if (!dir)
+        return false;
+
+    auto iter = dir->columns.find(key);
+    if (iter == dir->columns.end())
+        return false;
+
+    data.resize(iter->second.length);
+    fs->dynamic_forecast->load_vector_range(
+        SUMMARY_TABLE_KEY, iens, dir->column_offset(iter->second),
+        sizeof(double) * data.size(), data.data());
+    return true;
+}
+
+/**
+  Returns the complete summary table of realization iens; the table is
+  empty if the realization does not have one.
+*/
+ert::summary_table enkf_fs_fread_summary_table(enkf_fs_type *fs, int iens) {
+    if (!fs->dynamic_forecast->has_vector(SUMMARY_TABLE_KEY, iens))
+        return {};
+
+    buffer_type *buffer = buffer_alloc(1024);
+    fs->dynamic_forecast->load_vector(SUMMARY_TABLE_KEY, iens, buffer);
+    ert::summary_table table = ert::summary_table::fread(buffer);
+    buffer_free(buffer);
+    return table;
+}
+
+void enkf_fs_fwrite_summary_table(enkf_fs_type *fs,
+                                  const ert::summary_table &table, int iens) {
+    if (fs->read_only)
+        util_abort("%s: attempt to write to read_only filesystem mounted at:%s "
+                   "- aborting. \n",
+                   __func__, fs->mount_point);
+
+    buffer_type *buffer = buffer_alloc(1024);
+    table.fwrite(buffer);
+    fs->dynamic_forecast->save_vector(SUMMARY_TABLE_KEY, iens, buffer);
+    buffer_free(buffer);
+
+    auto dir = std::make_shared<const ert::summary_table::directory>(
+        table.get_directory());
+    std::lock_guard guard{fs->summary_mutex};
+    fs->summary_directories[iens] = dir;
+}
+
+/**
+  Cases written by older versions store one record per summary key and
+  realization. They can be read as they are, but loading results into such a
+  case, or reading one key across the ensemble, is much faster when the
+  vectors are collected in one summary table per realization. This function
+  copies the per key vectors of all realizations into the summary tables;
+  the vectors which are already in a table are not touched. Returns the
+  number of realizations which were migrated.
+*/
+int enkf_fs_migrate_summary(enkf_fs_type *fs) {
+    if (fs->read_only)
+        util_abort("%s: attempt to migrate read_only filesystem mounted at:%s "
+                   "- aborting. \n",
+                   __func__, fs->mount_point);
+
+    stringlist_type *keys = summary_key_set_alloc_keys(fs->summary_key_set);
+    summary_type *summary = summary_alloc(NULL);
+    buffer_type *buffer = buffer_alloc(1024);
+    int migrated = 0;
+    for (int iens = 0; iens < state_map_get_size(fs->state_map); iens++) {
+        ert::summary_table table = enkf_fs_fread_summary_table(fs, iens);
+        bool updated = false;
+        for (int ikey = 0; ikey < stringlist_get_size(keys); ikey++) {
+            const char *key = stringlist_iget(keys, ikey);
+            if (table.has_column(key) ||
+                !fs->dynamic_forecast->has_vector(key, iens))
+                continue;
+
+            buffer_clear(buffer);
+            fs->dynamic_forecast->load_vector(key, iens, buffer);
+            buffer_fskip_time_t(buffer);
+            summary_read_from_buffer__(summary, buffer, fs, -1);
+
+            table.set_column(key, summary_get_vector(summary));
+            updated = true;
+        }
+        if (updated) {
+            enkf_fs_fwrite_summary_table(fs, table, iens);
+            migrated++;
+        }
+    }
+    buffer_free(buffer);
+    summary_free(summary);
+    stringlist_free(keys);
+
+    logger->info("Migrated summary data of {} realizations in {} to summary "
+                 "tables",
+                 migrated, fs->mount_point);
+    return migrated;
 }
 
 void enkf_fs_fwrite_node(enkf_fs_type *enkf_fs, buffer_type *buffer,
@@ -644,6 +885,85 @@ void enkf_fs_fwrite_vector(enkf_fs_type *enkf_fs, buffer_type *buffer,
     driver->save_vector(node_key, iens, buffer);
 }
 
+/**
+  Rewrites the data files of the filesystem with only the live nodes, and
+  returns the number of bytes reclaimed. The filesystem must not be in use
+  by any other thread while it is compacted.
+*/
+long enkf_fs_compact(enkf_fs_type *fs) {
+    if (fs->read_only)
+        util_abort("%s: attempt to compact read_only filesystem mounted at:%s "
+                   "- aborting. \n",
+                   __func__, fs->mount_point);
+
+    long reclaimed = fs->parameter->compact() +
+                     fs->dynamic_forecast->compact() + fs->index->compact();
+    logger->info("Compacted filesystem {}: {} bytes reclaimed",
+                 fs->mount_point, reclaimed);
+    return reclaimed;
+}
+
+/**
+  Sets when the nodes written to this filesystem are fsync()'ed, see
+  bfs_durability_enum. The default is BFS_DURABILITY_WRITE.
+*/
+void enkf_fs_set_durability(enkf_fs_type *fs, bfs_durability_enum durability) {
+    if (fs->read_only)
+        return;
+
+    fs->parameter->set_durability(durability);
+    fs->dynamic_forecast->set_durability(durability);
+    fs->index->set_durability(durability);
+}
+
+enkf_fs_batch_type *enkf_fs_batch_alloc(enkf_fs_type *fs) {
+    return new enkf_fs_batch_type{fs, {}};
+}
+
+void enkf_fs_batch_free(enkf_fs_batch_type *batch) { delete batch; }
+
+void enkf_fs_batch_fwrite_node(enkf_fs_batch_type *batch,
+                               const buffer_type *buffer, const char *node_key,
+                               enkf_var_type var_type, int report_step,
+                               int iens) {
+    if (batch->fs->read_only)
+        util_abort("%s: attempt to write to read_only filesystem mounted at:%s "
+                   "- aborting. \n",
+                   __func__, batch->fs->mount_point);
+
+    if ((var_type == PARAMETER) && (report_step > 0))
+        util_abort(
+            "%s: Parameters can only be saved for report_step = 0   %s:%d\n",
+            __func__, node_key, report_step);
+    ert::block_fs_driver *driver =
+        enkf_fs_select_driver(batch->fs, var_type, node_key);
+    driver->save_node(batch->drivers[driver], node_key, report_step, iens,
+                      buffer);
+}
+
+void enkf_fs_batch_fwrite_vector(enkf_fs_batch_type *batch,
+                                 const buffer_type *buffer,
+                                 const char *node_key, enkf_var_type var_type,
+                                 int iens) {
+    if (batch->fs->read_only)
+        util_abort("%s: attempt to write to read_only filesystem mounted at:%s "
+                   "- aborting. \n",
+                   __func__, batch->fs->mount_point);
+
+    ert::block_fs_driver *driver =
+        enkf_fs_select_driver(batch->fs, var_type, node_key);
+    driver->save_vector(batch->drivers[driver], node_key, iens, buffer);
+}
+
+/**
+  Writes all the nodes in the batch to storage, with one write and at most
+  one fsync() per block_fs shard. The batch is empty afterwards.
+*/
+void enkf_fs_batch_commit(enkf_fs_batch_type *batch) {
+    for (auto &[driver, driver_batch] : batch->drivers)
+        driver->commit(driver_batch);
+}
+
 const char *enkf_fs_get_mount_point(const enkf_fs_type *fs) {
     return fs->mount_point;
 }
@@ -19,12 +19,18 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <algorithm>
+#include <filesystem>
 #include <future>
+#include <stdexcept>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <unordered_map>
 #include <vector>
 
+#include <fmt/format.h>
+
 #include <ert/python.hpp>
 #include <ert/res_util/path_fmt.hpp>
 #include <ert/util/bool_vector.h>
@@ -36,6 +42,7 @@
 
 #include <ert/logging.hpp>
 #include <ert/res_util/subst_list.hpp>
+#include <ert/res_util/subst_template.hpp>
 
 #include <ert/sched/history.hpp>
 
@@ -56,6 +63,8 @@
 
 #include <ert/python.hpp>
 
+namespace fs = std::filesystem;
+
 static auto logger = ert::get_logger("enkf");
 
 #define ENKF_MAIN_ID 8301
@@ -650,59 +659,128 @@ void ecl_write(const ensemble_config_type *ens_config,
 }
 
 /**
- * @brief Initializes all active runs.
+ * @brief Initializes a single run.
  *
- * For each active run:
  *  * Instantiate res_config_templates which substitutes arg_list from the template
  *      and from run_arg into each template and writes it to runpath;
  *  * substitutes sampled parameters into the parameter nodes and write to runpath;
  *  * substitutes DATAKW into the eclipse data file template and write it to runpath;
  *  * write the job script.
  *
+ * Only state belonging to run_arg is modified, so several runs can be
+ * initialized concurrently.
+ *
+ * Throws std::runtime_error if the runpath can not be created.
+ *
+ * @param res_config The config to use for initialization.
+ * @param run_arg The run to initialize.
+ */
+void init_active_run(const res_config_type *res_config,
+                     const run_arg_type *run_arg) {
+    // Fail with an exception rather than aborting, so the other runs which
+    // are initialized concurrently can complete.
+    std::error_code ec;
+    fs::create_directories(run_arg_get_runpath(run_arg), ec);
+    if (ec)
+        throw std::runtime_error(
+            fmt::format("Could not create runpath {}: {}",
+                        run_arg_get_runpath(run_arg), ec.message()));
+
+    model_config_type *model_config = res_config_get_model_config(res_config);
+    ensemble_config_type *ens_config =
+        res_config_get_ensemble_config(res_config);
+
+    ert_templates_instansiate(res_config_get_templates(res_config),
+                              run_arg_get_runpath(run_arg),
+                              run_arg_get_subst_list(run_arg));
+
+    ecl_write(ens_config, model_config_get_gen_kw_export_name(model_config),
+              run_arg, run_arg_get_sim_fs(run_arg));
+
+    // Create the eclipse data file (if eclbase and DATA_FILE)
+    const ecl_config_type *ecl_config = res_config_get_ecl_config(res_config);
+    const char *data_file_template = ecl_config_get_data_file(ecl_config);
+    if (ecl_config_have_eclbase(ecl_config) && data_file_template) {
+        write_eclipse_data_file(data_file_template, run_arg);
+    }
+
+    // Create the job script
+    const site_config_type *site_config =
+        res_config_get_site_config(res_config);
+    forward_model_formatted_fprintf(
+        model_config_get_forward_model(model_config),
+        run_arg_get_run_id(run_arg), run_arg_get_runpath(run_arg),
+        model_config_get_data_root(model_config),
+        run_arg_get_subst_list(run_arg), site_config_get_umask(site_config),
+        site_config_get_env_varlist(site_config));
+}
+
+/**
+ * @brief Initializes all active runs.
+ *
+ * Each active run is initialized with init_active_run() in a separate
+ * thread. Exporting the parameters is a mix of cpu work (decompressing and
+ * formatting fields) and io, so the number of concurrently executing
+ * threads is limited to the number of cores.
+ *
+ * A failing run does not stop the others; when all runs are done the
+ * failures are logged and reported together in one std::runtime_error.
+ *
  * @param res_config The config to use for initialization.
  * @param run_context Contains all the runs.
  */
 void init_active_runs(const res_config_type *res_config,
                       const ert_run_context_type *run_context) {
+    Semafoor concurrently_executing_threads(
+        std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<std::tuple<int, std::future<std::string>>> futures;
+
+    // See enkf_main_load_from_run_context(); the threads may need the GIL
+    // for logging.
+    PyThreadState *state = nullptr;
+    if (Py_IsInitialized() && PyGILState_Check() == 1)
+        state = PyEval_SaveThread();
+
     for (int iens = 0; iens < ert_run_context_get_size(run_context); iens++) {
         if (ert_run_context_iactive(run_context, iens)) {
-            run_arg_type *run_arg = ert_run_context_iget_arg(run_context, iens);
-            util_make_path(run_arg_get_runpath(run_arg));
-
-            model_config_type *model_config =
-                res_config_get_model_config(res_config);
-            ensemble_config_type *ens_config =
-                res_config_get_ensemble_config(res_config);
-
-            ert_templates_instansiate(res_config_get_templates(res_config),
-                                      run_arg_get_runpath(run_arg),
-                                      run_arg_get_subst_list(run_arg));
-
-            ecl_write(ens_config,
-                      model_config_get_gen_kw_export_name(model_config),
-                      run_arg, run_arg_get_sim_fs(run_arg));
-
-            // Create the eclipse data file (if eclbase and DATA_FILE)
-            const ecl_config_type *ecl_config =
-                res_config_get_ecl_config(res_config);
-            const char *data_file_template =
-                ecl_config_get_data_file(ecl_config);
-            if (ecl_config_have_eclbase(ecl_config) && data_file_template) {
-                write_eclipse_data_file(data_file_template, run_arg);
-            }
-
-            // Create the job script
-            const site_config_type *site_config =
-                res_config_get_site_config(res_config);
-            forward_model_formatted_fprintf(
-                model_config_get_forward_model(model_config),
-                run_arg_get_run_id(run_arg), run_arg_get_runpath(run_arg),
-                model_config_get_data_root(model_config),
-                run_arg_get_subst_list(run_arg),
-                site_config_get_umask(site_config),
-                site_config_get_env_varlist(site_config));
+            const run_arg_type *run_arg =
+                ert_run_context_iget_arg(run_context, iens);
+            futures.push_back(std::make_tuple(
+                iens,
+                std::async(
+                    std::launch::async,
+                    [=](Semafoor &execution_limiter) -> std::string {
+                        std::scoped_lock lock(execution_limiter);
+                        try {
+                            init_active_run(res_config, run_arg);
+                        } catch (const std::exception &e) {
+                            return e.what();
+                        }
+                        return "";
+                    },
+                    std::ref(concurrently_executing_threads))));
+        }
+    }
+
+    std::vector<int> failed;
+    for (auto &[iens, fut] : futures) {
+        auto error = fut.get();
+        if (!error.empty()) {
+            logger->error("Function {}: Realization {} failed: {}", __func__,
+                          iens, error);
+            failed.push_back(iens);
         }
     }
+    if (state)
+        PyEval_RestoreThread(state);
+
+    // The templates are only shared between the realizations of one batch
+    ert::subst_template::clear_cache();
+
+    if (!failed.empty())
+        throw std::runtime_error(
+            fmt::format("Failed to create the runpath of realization(s): {}",
+                        fmt::join(failed, ", ")));
 }
 
 /**
@@ -387,6 +387,9 @@ enkf_fs_type *enkf_main_mount_alt_fs(const enkf_main_type *enkf_main,
                 const ecl_sum_type *refcase =
                     model_config_get_refcase(model_config);
 
+                enkf_fs_set_durability(
+                    new_fs, model_config_get_storage_durability(model_config));
+
                 if (refcase) {
                     time_map_type *time_map = enkf_fs_get_time_map(new_fs);
                     if (!time_map_attach_refcase(time_map, refcase))
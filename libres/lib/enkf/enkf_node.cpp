@@ -405,8 +405,13 @@ bool enkf_node_forward_load_vector(
     return loadOK;
 }
 
+/**
+   Exactly one of fs and batch should be non NULL; when batch is given the
+   node is only written to storage when the batch is committed.
+*/
 static bool enkf_node_store_buffer(enkf_node_type *enkf_node, enkf_fs_type *fs,
-                                   int report_step, int iens) {
+                                   enkf_fs_batch_type *batch, int report_step,
+                                   int iens) {
     FUNC_ASSERT(enkf_node->write_to_buffer);
     {
         bool data_written;
@@ -420,7 +425,14 @@ static bool enkf_node_store_buffer(enkf_node_type *enkf_node, enkf_fs_type *fs,
             const char *node_key = enkf_config_node_get_key(config_node);
             enkf_var_type var_type = enkf_config_node_get_var_type(config_node);
 
-            if (enkf_node->vector_storage)
+            if (batch != NULL) {
+                if (enkf_node->vector_storage)
+                    enkf_fs_batch_fwrite_vector(batch, buffer, node_key,
+                                                var_type, iens);
+                else
+                    enkf_fs_batch_fwrite_node(batch, buffer, node_key, var_type,
+                                              report_step, iens);
+            } else if (enkf_node->vector_storage)
                 enkf_fs_fwrite_vector(fs, buffer, node_key, var_type, iens);
             else
                 enkf_fs_fwrite_node(fs, buffer, node_key, var_type, report_step,
@@ -433,7 +445,21 @@ static bool enkf_node_store_buffer(enkf_node_type *enkf_node, enkf_fs_type *fs,
 
 bool enkf_node_store_vector(enkf_node_type *enkf_node, enkf_fs_type *fs,
                             int iens) {
-    return enkf_node_store_buffer(enkf_node, fs, -1, iens);
+    return enkf_node_store_buffer(enkf_node, fs, NULL, -1, iens);
+}
+
+/**
+   As enkf_node_store(), but the node is written to storage when the batch is
+   committed with enkf_fs_batch_commit().
+*/
+bool enkf_node_store_batch(enkf_node_type *enkf_node, enkf_fs_batch_type *batch,
+                           node_id_type node_id) {
+    if (enkf_node->vector_storage)
+        return enkf_node_store_buffer(enkf_node, NULL, batch, -1,
+                                      node_id.iens);
+    else
+        return enkf_node_store_buffer(enkf_node, NULL, batch,
+                                      node_id.report_step, node_id.iens);
 }
 
 bool enkf_node_store(enkf_node_type *enkf_node, enkf_fs_type *fs,
@@ -441,7 +467,7 @@ bool enkf_node_store(enkf_node_type *enkf_node, enkf_fs_type *fs,
     if (enkf_node->vector_storage)
         return enkf_node_store_vector(enkf_node, fs, node_id.iens);
     else
-        return enkf_node_store_buffer(enkf_node, fs, node_id.report_step,
+        return enkf_node_store_buffer(enkf_node, fs, NULL, node_id.report_step,
                                       node_id.iens);
 }
 
@@ -467,27 +493,48 @@ static void enkf_node_buffer_load(enkf_node_type *enkf_node, enkf_fs_type *fs,
                                   int report_step, int iens) {
     FUNC_ASSERT(enkf_node->read_from_buffer);
     {
-        buffer_type *buffer = buffer_alloc(100);
         const enkf_config_node_type *config_node =
             enkf_node_get_config(enkf_node);
         const char *node_key = enkf_config_node_get_key(config_node);
         enkf_var_type var_type = enkf_config_node_get_var_type(config_node);
 
+        // Decode directly from the storage if it is memory mapped, otherwise
+        // read the node into a private buffer first.
+        buffer_type *buffer;
         if (enkf_node->vector_storage)
-            enkf_fs_fread_vector(fs, buffer, node_key, var_type, iens);
+            buffer = enkf_fs_alloc_vector_view(fs, node_key, var_type, iens);
         else
-            enkf_fs_fread_node(fs, buffer, node_key, var_type, report_step,
-                               iens);
+            buffer = enkf_fs_alloc_node_view(fs, node_key, var_type,
+                                             report_step, iens);
+        const bool view = (buffer != NULL);
+
+        if (!view) {
+            buffer = buffer_alloc(100);
+            if (enkf_node->vector_storage)
+                enkf_fs_fread_vector(fs, buffer, node_key, var_type, iens);
+            else
+                enkf_fs_fread_node(fs, buffer, node_key, var_type, report_step,
+                                   iens);
+        }
 
         buffer_fskip_time_t(buffer);
 
         enkf_node->read_from_buffer(enkf_node->data, buffer, fs, report_step);
-        buffer_free(buffer);
+        if (view)
+            buffer_free_container(buffer);
+        else
+            buffer_free(buffer);
     }
 }
 
 void enkf_node_load_vector(enkf_node_type *enkf_node, enkf_fs_type *fs,
                            int iens) {
+    // The summary vectors are normally stored in the summary table of the
+    // realization, cases written by older versions have one record per key.
+    if (enkf_node_get_impl_type(enkf_node) == SUMMARY &&
+        summary_fread_table_vector((summary_type *)enkf_node->data, fs, iens))
+        return;
+
     enkf_node_buffer_load(enkf_node, fs, -1, iens);
 }
 
@@ -515,6 +562,26 @@ void enkf_node_load(enkf_node_type *enkf_node, enkf_fs_type *fs,
     }
 }
 
+/**
+  Loads only the cells with the given active indices of a FIELD node, see
+  field_load_cells(). Returns false if the node is not a FIELD, or if it was
+  not stored in a format which supports partial loading; the node must then be
+  loaded with enkf_node_load().
+*/
+bool enkf_node_load_cells(enkf_node_type *enkf_node, enkf_fs_type *fs,
+                          node_id_type node_id,
+                          const std::vector<int> &active_index) {
+    if (enkf_node_get_impl_type(enkf_node) != FIELD ||
+        enkf_node->vector_storage)
+        return false;
+
+    const enkf_config_node_type *config_node = enkf_node_get_config(enkf_node);
+    return field_load_cells(
+        (field_type *)enkf_node->data, fs,
+        enkf_config_node_get_key(config_node),
+        enkf_config_node_get_var_type(config_node), node_id, active_index);
+}
+
 bool enkf_node_try_load_vector(enkf_node_type *enkf_node, enkf_fs_type *fs,
                                int iens) {
     if (enkf_config_node_has_vector(enkf_node->config, fs, iens)) {
@@ -16,7 +16,11 @@
    for more details.
 */
 
+#include <algorithm>
 #include <cmath>
+#include <future>
+#include <thread>
+
 #include <ert/util/hash.h>
 #include <ert/util/type_vector_functions.h>
 #include <ert/util/vector.h>
@@ -303,11 +307,10 @@ static void enkf_obs_get_obs_and_measure_summary(
     enkf_fs_type *fs, const std::vector<int> &ens_active_list,
     meas_data_type *meas_data, obs_data_type *obs_data) {
 
-    int active_count = 0;
-    int last_step = -1;
     int step = -1;
 
     /*1: Determine which report_steps have active observations; and collect the observed values. */
+    std::vector<int> active_steps;
     std::vector<std::pair<double, double>> observations;
     while (true) {
         step = obs_vector_get_next_active_step(obs_vector, step);
@@ -319,69 +322,101 @@ static void enkf_obs_get_obs_and_measure_summary(
         observations.push_back({summary_obs_get_value(summary_obs),
                                 summary_obs_get_std(summary_obs) *
                                     summary_obs_get_std_scaling(summary_obs)});
-        last_step = step;
-        active_count++;
+        active_steps.push_back(step);
     }
 
+    const int active_count = active_steps.size();
     if (active_count <= 0)
         return;
 
+    /*
+    2: Gather the simulated values. The summary node has vector storage, i.e.
+       all report steps of one realization are stored as one record, so each
+       realization is loaded exactly once and all the active steps are picked
+       out of the loaded vector. The realizations are distributed over a set of
+       worker threads, each worker reusing one enkf_node instance.
+  */
+    const int active_size = ens_active_list.size();
+    std::vector<std::vector<double>> simulated(active_size);
+    std::vector<int> sim_length(active_size);
+    {
+        const enkf_config_node_type *config_node =
+            obs_vector_get_config_node(obs_vector);
+        const int num_workers = std::max(
+            1, std::min<int>(std::thread::hardware_concurrency(), active_size));
+
+        auto gather = [&](int worker) {
+            enkf_node_type *work_node = enkf_node_alloc(config_node);
+            for (int iens_index = worker; iens_index < active_size;
+                 iens_index += num_workers) {
+                node_id_type node_id = {.report_step = 0,
+                                        .iens = ens_active_list[iens_index]};
+                enkf_node_load(work_node, fs, node_id);
+
+                const summary_type *summary =
+                    (const summary_type *)enkf_node_value_ptr(work_node);
+                const int smlength = summary_length(summary);
+                auto &values = simulated[iens_index];
+
+                values.resize(active_count);
+                for (int i = 0; i < active_count; i++)
+                    if (active_steps[i] < smlength)
+                        values[i] = summary_get(summary, active_steps[i]);
+
+                sim_length[iens_index] = smlength;
+            }
+            enkf_node_free(work_node);
+        };
+
+        std::vector<std::future<void>> futures;
+        for (int worker = 1; worker < num_workers; worker++)
+            futures.push_back(std::async(std::launch::async, gather, worker));
+        gather(0);
+
+        for (auto &fut : futures)
+            fut.get();
+    }
+
     /*
     3: Fill up the obs_block and meas_block structures with this
     time-aggregated summary observation.
   */
-
     {
         obs_block_type *obs_block = obs_data_add_block(
             obs_data, obs_vector_get_obs_key(obs_vector), active_count);
-        meas_block_type *meas_block =
-            meas_data_add_block(meas_data, obs_vector_get_obs_key(obs_vector),
-                                last_step, active_count);
-
-        enkf_node_type *work_node =
-            enkf_node_alloc(obs_vector_get_config_node(obs_vector));
+        meas_block_type *meas_block = meas_data_add_block(
+            meas_data, obs_vector_get_obs_key(obs_vector), active_steps.back(),
+            active_count);
 
         for (int i = 0; i < active_count; i++)
             obs_block_iset(obs_block, i, observations[i].first,
                            observations[i].second);
 
-        int active_size = ens_active_list.size();
-        active_count = 0;
-        step = -1;
-        while (true) {
-            step = obs_vector_get_next_active_step(obs_vector, step);
-            if (step < 0)
-                break;
-
+        for (int i = 0; i < active_count; i++) {
+            const int report_step = active_steps[i];
+            bool valid = true;
             for (int iens_index = 0; iens_index < active_size; iens_index++) {
-                const int iens = ens_active_list[iens_index];
-                node_id_type node_id = {.report_step = step, .iens = iens};
-                enkf_node_load(work_node, fs, node_id);
-
-                int smlength = summary_length(
-                    (const summary_type *)enkf_node_value_ptr(work_node));
-                if (step >= smlength) {
+                if (report_step >= sim_length[iens_index]) {
                     // if obs vector and sim vector have different length
                     // deactivate and continue to next
                     char *msg = util_alloc_sprintf(
                         "length of observation vector and simulated "
                         "differ: %d vs. %d ",
-                        step, smlength);
-                    meas_block_deactivate(meas_block, active_count);
-                    obs_block_deactivate(obs_block, active_count, msg);
+                        report_step, sim_length[iens_index]);
+                    meas_block_deactivate(meas_block, i);
+                    obs_block_deactivate(obs_block, i, msg);
                     free(msg);
+                    valid = false;
                     break;
-                } else {
-                    meas_block_iset(
-                        meas_block, iens, active_count,
-                        summary_get((const summary_type *)enkf_node_value_ptr(
-                                        work_node),
-                                    node_id.report_step));
                 }
             }
-            active_count++;
+
+            if (valid)
+                for (int iens_index = 0; iens_index < active_size;
+                     iens_index++)
+                    meas_block_iset(meas_block, ens_active_list[iens_index], i,
+                                    simulated[iens_index][i]);
         }
-        enkf_node_free(work_node);
     }
 }
 
@@ -38,6 +38,7 @@
 #include <ert/enkf/enkf_node.hpp>
 #include <ert/enkf/enkf_state.hpp>
 #include <ert/enkf/gen_data.hpp>
+#include <ert/enkf/summary.hpp>
 #include <ert/logging.hpp>
 
 static auto logger = ert::get_logger("enkf");
@@ -288,32 +289,65 @@ static bool enkf_state_internalize_dynamic_eclipse_results(
 
                 const ecl_smspec_type *smspec = ecl_sum_get_smspec(summary);
 
+                // All the summary vectors of the realization are collected in
+                // one summary table, which is read and written once. The
+                // report step -> ministep mapping is resolved once, and the
+                // matched vectors are gathered in one pass over the ecl_sum
+                // data.
+                ert::summary_table table =
+                    enkf_fs_fread_summary_table(sim_fs, iens);
+                const summary_load_plan plan =
+                    summary_alloc_load_plan(summary, time_index);
+                summary_key_set_type *key_set =
+                    enkf_fs_get_summary_key_set(sim_fs);
+                std::vector<std::string> keys;
+                std::vector<int> params_index;
+                std::vector<std::vector<double>> columns;
+                const auto selection =
+                    summary_key_matcher_match_smspec(matcher, smspec);
                 for (int i = 0; i < ecl_smspec_num_nodes(smspec); i++) {
+                    if (!(*selection)[i])
+                        continue;
+
                     const ecl::smspec_node &smspec_node =
                         ecl_smspec_iget_node_w_node_index(smspec, i);
                     const char *key = smspec_node.get_gen_key1();
 
-                    if (summary_key_matcher_match_summary_key(matcher, key)) {
-                        summary_key_set_type *key_set =
-                            enkf_fs_get_summary_key_set(sim_fs);
-                        summary_key_set_add_summary_key(key_set, key);
-
-                        enkf_config_node_type *config_node =
-                            ensemble_config_get_or_create_summary_node(
-                                ens_config, key);
+                    summary_key_set_add_summary_key(key_set, key);
+                    enkf_config_node_type *config_node =
+                        ensemble_config_get_or_create_summary_node(ens_config,
+                                                                   key);
+                    const summary_config_type *summary_config =
+                        (const summary_config_type *)enkf_config_node_get_ref(
+                            config_node);
+                    if (summary_config_get_load_fail_mode(summary_config) ==
+                        LOAD_FAIL_EXIT)
+                        continue;
+
+                    // Ensure that what is currently on file is loaded before
+                    // we update. A node is only needed to decode a legacy
+                    // per key record; otherwise the key starts out empty.
+                    if (table.has_column(key))
+                        columns.push_back(table.get_column(key));
+                    else if (enkf_fs_has_vector(sim_fs, key, DYNAMIC_RESULT,
+                                                iens)) {
                         enkf_node_type *node = enkf_node_alloc(config_node);
-
-                        // Ensure that what is currently on file is loaded
-                        // before we update.
-                        enkf_node_try_load_vector(node, sim_fs, iens);
-
-                        enkf_node_forward_load_vector(node, load_context,
-                                                      time_index);
-                        enkf_node_store_vector(node, sim_fs, iens);
+                        enkf_node_load_vector(node, sim_fs, iens);
+                        columns.push_back(summary_get_vector(
+                            (const summary_type *)enkf_node_value_ptr(node)));
                         enkf_node_free(node);
-                    }
+                    } else
+                        columns.emplace_back();
+                    keys.push_back(key);
+                    params_index.push_back(
+                        ecl_sum_get_general_var_params_index(summary, key));
                 }
 
+                summary_load_plan_gather(plan, summary, params_index, columns);
+                for (size_t i = 0; i < keys.size(); i++)
+                    table.set_column(keys[i], std::move(columns[i]));
+                enkf_fs_fwrite_summary_table(sim_fs, table, iens);
+
                 int_vector_free(time_index);
 
                 // Check if some of the specified keys are missing from the Eclipse
@@ -336,8 +370,8 @@ static bool enkf_state_internalize_dynamic_eclipse_results(
 }
 
 static void enkf_state_load_gen_data_node(
-    forward_load_context_type *load_context, enkf_fs_type *sim_fs, int iens,
-    const enkf_config_node_type *config_node, int start, int stop) {
+    forward_load_context_type *load_context, enkf_fs_batch_type *batch,
+    int iens, const enkf_config_node_type *config_node, int start, int stop) {
     for (int report_step = start; report_step <= stop; report_step++) {
         if (!enkf_config_node_internalize(config_node, report_step))
             continue;
@@ -348,7 +382,7 @@ static void enkf_state_load_gen_data_node(
         if (enkf_node_forward_load(node, load_context)) {
             node_id_type node_id = {.report_step = report_step, .iens = iens};
 
-            enkf_node_store(node, sim_fs, node_id);
+            enkf_node_store_batch(node, batch, node_id);
             logger->info("Loaded GEN_DATA: {} instance for step: {} from file: "
                          "{} size: {}",
                          enkf_node_get_key(node), report_step,
@@ -389,6 +423,9 @@ enkf_state_internalize_GEN_DATA(const ensemble_config_type *ens_config,
     enkf_fs_type *sim_fs = run_arg_get_sim_fs(run_arg);
     const int iens = run_arg_get_iens(run_arg);
 
+    // All the GEN_DATA nodes of the realization are written to storage with
+    // one write when the batch is committed.
+    enkf_fs_batch_type *batch = enkf_fs_batch_alloc(sim_fs);
     for (int ikey = 0; ikey < numkeys; ikey++) {
         const enkf_config_node_type *config_node = ensemble_config_get_node(
             ens_config, stringlist_iget(keylist_GEN_DATA, ikey));
@@ -398,9 +435,11 @@ enkf_state_internalize_GEN_DATA(const ensemble_config_type *ens_config,
         // spinning through them all.
         int start = run_arg_get_load_start(run_arg);
         int stop = util_int_max(0, last_report); // inclusive
-        enkf_state_load_gen_data_node(load_context, sim_fs, iens, config_node,
+        enkf_state_load_gen_data_node(load_context, batch, iens, config_node,
                                       start, stop);
     }
+    enkf_fs_batch_commit(batch);
+    enkf_fs_batch_free(batch);
     stringlist_free(keylist_GEN_DATA);
 }
 
@@ -44,6 +44,7 @@
 #include <ert/enkf/enkf_defaults.hpp>
 #include <ert/enkf/enkf_obs.hpp>
 #include <ert/enkf/ensemble_config.hpp>
+#include <ert/enkf/field_config.hpp>
 #include <ert/enkf/gen_kw_config.hpp>
 #include <ert/logging.hpp>
 
@@ -528,6 +529,34 @@ void ensemble_config_init_SUMMARY_full(ensemble_config_type *ensemble_config,
     }
 }
 
+/**
+   The COMPRESSION:NONE|LZ4|ZLIB and SHUFFLE:True|False options of a FIELD
+   select how the field is compressed in storage; the default is ZLIB without
+   shuffling.
+*/
+static void ensemble_config_init_field_codec(
+    enkf_config_node_type *config_node,
+    const std::unordered_map<std::string, std::string> &opt_map) {
+    field_codec_enum codec = FIELD_CODEC_ZLIB;
+    bool shuffle = false;
+
+    const char *codec_string = get_string(opt_map, COMPRESSION_KEY);
+    if (codec_string && !field_codec_from_string(codec_string, &codec))
+        fprintf(stderr,
+                "** Warning: compression:%s not recognized - using ZLIB \n",
+                codec_string);
+
+    const char *shuffle_string = get_string(opt_map, SHUFFLE_KEY);
+    if (shuffle_string && !util_sscanf_bool(shuffle_string, &shuffle))
+        fprintf(stderr,
+                "** Warning: parsing %s as bool failed - using FALSE \n",
+                shuffle_string);
+
+    field_config_set_codec(
+        (field_config_type *)enkf_config_node_get_ref(config_node), codec,
+        shuffle);
+}
+
 static void ensemble_config_init_FIELD(ensemble_config_type *ensemble_config,
                                        const config_content_type *config,
                                        ecl_grid_type *grid) {
@@ -619,6 +648,8 @@ static void ensemble_config_init_FIELD(ensemble_config_type *ensemble_config,
                 } else
                     util_abort("%s: field type: %s is not recognized\n",
                                __func__, var_type_string);
+
+                ensemble_config_init_field_codec(config_node, opt_map);
             }
         }
     }
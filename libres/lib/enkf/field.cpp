@@ -19,7 +19,10 @@
 #include <filesystem>
 
 #include <Eigen/Dense>
+#include <algorithm>
 #include <cmath>
+#include <stdexcept>
+#include <vector>
 #include <stdlib.h>
 #include <string.h>
 
@@ -35,6 +38,7 @@
 #include <ert/rms/rms_file.hpp>
 #include <ert/rms/rms_util.hpp>
 
+#include <ert/enkf/enkf_fs.hpp>
 #include <ert/enkf/field.hpp>
 
 namespace fs = std::filesystem;
@@ -384,13 +388,74 @@ C_USED void field_copy(const field_type *src, field_type *target) {
         util_abort("%s: instances do not share config \n", __func__);
 }
 
+/**
+   Loads the cells with the given active indices from the stored field in fs,
+   without reading the rest of the field: only the compressed chunks (see
+   field_codec.cpp) holding the cells are read and decompressed. The other
+   cells of the field are left untouched, so e.g. field_iget_double() is only
+   valid for the loaded cells afterwards.
+
+   Returns false, without loading anything, if the field was stored before
+   it was chunked; it must then be loaded completely with enkf_node_load().
+*/
+bool field_load_cells(field_type *field, enkf_fs_type *fs, const char *key,
+                      enkf_var_type var_type, node_id_type node_id,
+                      const std::vector<int> &active_index) {
+    // The stored node is: <time_t><FIELD: Int><field_codec header ...>
+    const size_t record_offset = sizeof(time_t) + sizeof(int);
+    const size_t byte_size = field_config_get_byte_size(field->config);
+    const int sizeof_ctype = field_config_get_sizeof_ctype(field->config);
+
+    field_codec_layout layout;
+    try {
+        char header[sizeof(int) + FIELD_CODEC_HEADER_SIZE];
+        enkf_fs_fread_node_range(fs, key, var_type, node_id.report_step,
+                                 node_id.iens, sizeof(time_t), sizeof header,
+                                 header);
+        int impl_type;
+        memcpy(&impl_type, header, sizeof impl_type);
+        if (impl_type != FIELD)
+            util_abort("%s: wrong target type in file (expected:%d  got:%d)\n",
+                       __func__, FIELD, impl_type);
+        if (!field_codec_fread_header(header + sizeof(int), &layout))
+            return false;
+    } catch (const std::out_of_range &) {
+        // A small field which was stored as one zlib stream
+        return false;
+    }
+
+    std::vector<char> chunk_index(field_codec_chunk_index_size(layout));
+    enkf_fs_fread_node_range(fs, key, var_type, node_id.report_step,
+                             node_id.iens,
+                             record_offset + FIELD_CODEC_HEADER_SIZE,
+                             chunk_index.size(), chunk_index.data());
+    field_codec_fread_chunk_index(chunk_index.data(), &layout);
+
+    std::vector<int> chunks;
+    for (int index : active_index)
+        chunks.push_back((size_t)index * sizeof_ctype / layout.chunk_size);
+    std::sort(chunks.begin(), chunks.end());
+    chunks.erase(std::unique(chunks.begin(), chunks.end()), chunks.end());
+
+    std::vector<char> compressed;
+    for (int chunk : chunks) {
+        const size_t offset = layout.chunk_offsets[chunk];
+        compressed.resize(layout.chunk_offsets[chunk + 1] - offset);
+        enkf_fs_fread_node_range(fs, key, var_type, node_id.report_step,
+                                 node_id.iens, record_offset + offset,
+                                 compressed.size(), compressed.data());
+        field_codec_decode_chunk(layout, chunk, compressed.data(), field->data,
+                                 byte_size);
+    }
+    return true;
+}
+
 void field_read_from_buffer(field_type *field, buffer_type *buffer,
                             enkf_fs_type *fs, int report_step) {
     int byte_size = field_config_get_byte_size(field->config);
     enkf_util_assert_buffer_type(buffer,
                                  FIELD); // FIXME flaky runpath_list test
-    buffer_fread_compressed(buffer, buffer_get_remaining_size(buffer),
-                            field->data, byte_size);
+    field_codec_fread(buffer, field->data, byte_size);
 }
 
 static void *__field_alloc_3D_data(const field_type *field, int data_size,
@@ -438,8 +503,8 @@ static void *__field_alloc_3D_data(const field_type *field, int data_size,
 
    o The native function field_fwrite() will save the field in the
      format most suitable for use with enkf. This function will only
-     save the active cells, and compress the field if the variable
-     write_compressed is true. Most of the configuration information
+     save the active cells, compressed with the codec configured in
+     field_config (see field_codec.cpp). Most of the configuration information
      is with the field_config object, and not saved with the field.
 
    o Export as ECLIPSE input. This again has three subdivisions:
@@ -538,7 +603,10 @@ bool field_write_to_buffer(const field_type *field, buffer_type *buffer,
                            int report_step) {
     int byte_size = field_config_get_byte_size(field->config);
     buffer_fwrite_int(buffer, FIELD);
-    buffer_fwrite_compressed(buffer, field->data, byte_size);
+    field_codec_fwrite(buffer, field->data, byte_size,
+                       field_config_get_sizeof_ctype(field->config),
+                       field_config_get_codec(field->config),
+                       field_config_get_shuffle(field->config));
     return true;
 }
 
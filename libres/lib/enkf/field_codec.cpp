@@ -0,0 +1,286 @@
+/*
+   Copyright (C) 2022  Equinor ASA, Norway.
+
+   The file 'field_codec.cpp' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <lz4.h>
+
+#include <ert/util/util.h>
+
+#include <ert/enkf/field_codec.hpp>
+
+/**
+   The stored FIELD data starts with a header and a chunk index:
+
+     |<magic: Int><codec: Int><shuffle_size: Int><num_chunks: Int>
+      <chunk_size: Int64>|<chunk_offsets: (num_chunks + 1) x Int64>|
+     |<chunk 0>|<chunk 1>|...|
+
+   The data is split in chunks of chunk_size bytes (the last chunk can be
+   shorter) which are shuffled and compressed independently. The chunk
+   offsets are relative to the start of the header. The shuffle_size is the
+   element size the bytes were shuffled with, or 0 if they were not shuffled.
+
+   Records written before the codec was configurable have no header, and are
+   a zlib stream directly. A zlib stream written by libecl starts with the
+   byte 0x78, so the magic is chosen with a different first byte.
+*/
+#define FIELD_CODEC_MAGIC 8141502
+
+bool field_codec_from_string(const char *codec_string,
+                             field_codec_enum *codec) {
+    if (util_string_equal(codec_string, FIELD_CODEC_NONE_STRING))
+        *codec = FIELD_CODEC_NONE;
+    else if (util_string_equal(codec_string, FIELD_CODEC_LZ4_STRING))
+        *codec = FIELD_CODEC_LZ4;
+    else if (util_string_equal(codec_string, FIELD_CODEC_ZLIB_STRING))
+        *codec = FIELD_CODEC_ZLIB;
+    else
+        return false;
+    return true;
+}
+
+const char *field_codec_to_string(field_codec_enum codec) {
+    switch (codec) {
+    case FIELD_CODEC_NONE:
+        return FIELD_CODEC_NONE_STRING;
+    case FIELD_CODEC_LZ4:
+        return FIELD_CODEC_LZ4_STRING;
+    case FIELD_CODEC_ZLIB:
+        return FIELD_CODEC_ZLIB_STRING;
+    }
+    util_abort("%s: invalid codec:%d\n", __func__, codec);
+    return NULL;
+}
+
+/**
+   The byte shuffle filter: byte j of element i is moved to position
+   j * num_elements + i, so the (slowly varying) exponent and high mantissa
+   bytes of float data end up next to each other, which makes the data
+   much more compressible.
+*/
+static void field_codec_shuffle(const char *src, char *target,
+                                size_t byte_size, int element_size) {
+    const size_t num_elements = byte_size / element_size;
+    for (size_t i = 0; i < num_elements; i++)
+        for (int j = 0; j < element_size; j++)
+            target[j * num_elements + i] = src[i * element_size + j];
+
+    // A tail which is not a whole element is stored as is.
+    const size_t tail = num_elements * element_size;
+    memcpy(target + tail, src + tail, byte_size - tail);
+}
+
+static void field_codec_unshuffle(const char *src, char *target,
+                                  size_t byte_size, int element_size) {
+    const size_t num_elements = byte_size / element_size;
+    for (size_t i = 0; i < num_elements; i++)
+        for (int j = 0; j < element_size; j++)
+            target[i * element_size + j] = src[j * num_elements + i];
+
+    const size_t tail = num_elements * element_size;
+    memcpy(target + tail, src + tail, byte_size - tail);
+}
+
+/**
+   Writes byte_size bytes of data to the buffer with the given codec, the
+   shuffle filter is applied first if shuffle is true. This must be the last
+   content written to the buffer.
+*/
+void field_codec_fwrite(buffer_type *buffer, const void *data,
+                        size_t byte_size, int element_size,
+                        field_codec_enum codec, bool shuffle) {
+    if (!shuffle || element_size <= 1)
+        element_size = 0;
+
+    // The chunks hold whole elements, so they can be unshuffled one by one.
+    size_t chunk_size = FIELD_CODEC_CHUNK_SIZE;
+    if (element_size > 0)
+        chunk_size -= chunk_size % element_size;
+    const int num_chunks = (byte_size + chunk_size - 1) / chunk_size;
+
+    std::vector<char> shuffled(element_size > 0 ? chunk_size : 0);
+    std::vector<size_t> chunk_offsets(num_chunks + 1);
+    buffer_type *compressed = buffer_alloc(byte_size / 2 + 1024);
+    const size_t data_offset = FIELD_CODEC_HEADER_SIZE +
+                               chunk_offsets.size() * sizeof(int64_t);
+    for (int chunk = 0; chunk < num_chunks; chunk++) {
+        const size_t offset = chunk * chunk_size;
+        const size_t size = std::min(chunk_size, byte_size - offset);
+        const char *chunk_data = (const char *)data + offset;
+        if (element_size > 0) {
+            field_codec_shuffle(chunk_data, shuffled.data(), size,
+                                element_size);
+            chunk_data = shuffled.data();
+        }
+
+        chunk_offsets[chunk] = data_offset + buffer_get_size(compressed);
+        switch (codec) {
+        case FIELD_CODEC_NONE:
+            buffer_fwrite(compressed, chunk_data, 1, size);
+            break;
+        case FIELD_CODEC_LZ4: {
+            std::vector<char> target(LZ4_compressBound(size));
+            const int target_size = LZ4_compress_default(
+                chunk_data, target.data(), size, target.size());
+            if (target_size <= 0)
+                util_abort("%s: LZ4 compression of %zu bytes failed\n",
+                           __func__, size);
+            buffer_fwrite(compressed, target.data(), 1, target_size);
+            break;
+        }
+        case FIELD_CODEC_ZLIB:
+            buffer_fwrite_compressed(compressed, chunk_data, size);
+            break;
+        default:
+            util_abort("%s: invalid codec:%d\n", __func__, codec);
+        }
+    }
+    chunk_offsets[num_chunks] = data_offset + buffer_get_size(compressed);
+
+    buffer_fwrite_int(buffer, FIELD_CODEC_MAGIC);
+    buffer_fwrite_int(buffer, codec);
+    buffer_fwrite_int(buffer, element_size);
+    buffer_fwrite_int(buffer, num_chunks);
+    const int64_t chunk_size64 = chunk_size;
+    buffer_fwrite(buffer, &chunk_size64, sizeof chunk_size64, 1);
+    for (size_t offset : chunk_offsets) {
+        const int64_t offset64 = offset;
+        buffer_fwrite(buffer, &offset64, sizeof offset64, 1);
+    }
+    buffer_fwrite(buffer, buffer_get_data(compressed), 1,
+                  buffer_get_size(compressed));
+    buffer_free(compressed);
+}
+
+/**
+   Parses the fixed size header of a stored field, which is the first
+   FIELD_CODEC_HEADER_SIZE bytes of the record. Returns false if the record
+   was written without a header, i.e. it is one zlib stream. The chunk index
+   which follows the header must be read with field_codec_fread_chunk_index().
+*/
+bool field_codec_fread_header(const char *header, field_codec_layout *layout) {
+    int values[4];
+    memcpy(values, header, sizeof values);
+    if (values[0] != FIELD_CODEC_MAGIC)
+        return false;
+
+    int64_t chunk_size;
+    memcpy(&chunk_size, header + sizeof values, sizeof chunk_size);
+    layout->codec = (field_codec_enum)values[1];
+    layout->shuffle_size = values[2];
+    layout->chunk_size = chunk_size;
+    layout->chunk_offsets.resize(values[3] + 1);
+    return true;
+}
+
+/** The size of the chunk index which follows the header. */
+size_t field_codec_chunk_index_size(const field_codec_layout &layout) {
+    return layout.chunk_offsets.size() * sizeof(int64_t);
+}
+
+void field_codec_fread_chunk_index(const char *chunk_index,
+                                   field_codec_layout *layout) {
+    for (size_t i = 0; i < layout->chunk_offsets.size(); i++) {
+        int64_t offset;
+        memcpy(&offset, chunk_index + i * sizeof offset, sizeof offset);
+        layout->chunk_offsets[i] = offset;
+    }
+}
+
+/**
+   Decompresses one chunk into its position in data, which is the complete
+   field of byte_size bytes.
+*/
+void field_codec_decode_chunk(const field_codec_layout &layout, int chunk,
+                              const char *compressed, void *data,
+                              size_t byte_size) {
+    const size_t offset = chunk * layout.chunk_size;
+    const size_t size = std::min(layout.chunk_size, byte_size - offset);
+    const size_t compressed_size =
+        layout.chunk_offsets[chunk + 1] - layout.chunk_offsets[chunk];
+
+    std::vector<char> shuffled(layout.shuffle_size > 0 ? size : 0);
+    char *target = (char *)data + offset;
+    if (layout.shuffle_size > 0)
+        target = shuffled.data();
+
+    switch (layout.codec) {
+    case FIELD_CODEC_NONE:
+        if (compressed_size != size)
+            util_abort("%s: expected %zu bytes of field data, got %zu\n",
+                       __func__, size, compressed_size);
+        memcpy(target, compressed, size);
+        break;
+    case FIELD_CODEC_LZ4: {
+        const int decompressed_size =
+            LZ4_decompress_safe(compressed, target, compressed_size, size);
+        if (decompressed_size < 0 || (size_t)decompressed_size != size)
+            util_abort("%s: LZ4 decompression of field data failed\n",
+                       __func__);
+        break;
+    }
+    case FIELD_CODEC_ZLIB: {
+        buffer_type *wrapper = buffer_alloc_private_wrapper(
+            const_cast<char *>(compressed), compressed_size);
+        buffer_fread_compressed(wrapper, compressed_size, target, size);
+        buffer_free_container(wrapper);
+        break;
+    }
+    default:
+        util_abort("%s: invalid codec:%d\n", __func__, layout.codec);
+    }
+
+    if (layout.shuffle_size > 0)
+        field_codec_unshuffle(target, (char *)data + offset, size,
+                              layout.shuffle_size);
+}
+
+/**
+   Reads byte_size bytes of data written by field_codec_fwrite(), or by the
+   zlib compression used before the codec was stored; the data runs to the end
+   of the buffer.
+*/
+void field_codec_fread(buffer_type *buffer, void *data, size_t byte_size) {
+    const char *record =
+        (const char *)buffer_get_data(buffer) + buffer_get_offset(buffer);
+    const size_t record_size = buffer_get_remaining_size(buffer);
+
+    field_codec_layout layout;
+    if (record_size < FIELD_CODEC_HEADER_SIZE ||
+        !field_codec_fread_header(record, &layout)) {
+        buffer_fread_compressed(buffer, record_size, data, byte_size);
+        return;
+    }
+
+    if (record_size <
+        FIELD_CODEC_HEADER_SIZE + field_codec_chunk_index_size(layout))
+        util_abort("%s: truncated field record\n", __func__);
+    field_codec_fread_chunk_index(record + FIELD_CODEC_HEADER_SIZE, &layout);
+    if (layout.chunk_offsets.back() > record_size)
+        util_abort("%s: truncated field record\n", __func__);
+
+    for (int chunk = 0; chunk < layout.num_chunks(); chunk++)
+        field_codec_decode_chunk(layout, chunk,
+                                 record + layout.chunk_offsets[chunk], data,
+                                 byte_size);
+    buffer_fseek(buffer, layout.chunk_offsets.back(), SEEK_CUR);
+}
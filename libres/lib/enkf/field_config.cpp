@@ -136,7 +136,10 @@ struct field_config_struct {
     ecl_data_type internal_data_type;
     /** See doc of functions field_config_set_key() / field_config_enkf_OFF() */
     bool __enkf_mode;
-    bool write_compressed;
+    /** How the data is compressed when it is stored in enkf_fs. */
+    field_codec_enum codec;
+    /** Whether the bytes are shuffled before they are compressed. */
+    bool shuffle;
 
     field_type_enum type;
     field_type *min_std;
@@ -319,7 +322,8 @@ field_config_type *field_config_alloc_empty(const char *ecl_kw_name,
     config->private_grid = false;
     config->__enkf_mode = true;
     config->grid = NULL;
-    config->write_compressed = true;
+    config->codec = FIELD_CODEC_ZLIB;
+    config->shuffle = false;
     config->type = UNKNOWN_FIELD_TYPE;
 
     config->output_transform = NULL;
@@ -583,6 +587,20 @@ int field_config_get_sizeof_ctype(const field_config_type *config) {
     return ecl_type_get_sizeof_ctype(config->internal_data_type);
 }
 
+void field_config_set_codec(field_config_type *config, field_codec_enum codec,
+                            bool shuffle) {
+    config->codec = codec;
+    config->shuffle = shuffle;
+}
+
+field_codec_enum field_config_get_codec(const field_config_type *config) {
+    return config->codec;
+}
+
+bool field_config_get_shuffle(const field_config_type *config) {
+    return config->shuffle;
+}
+
 /**
    Returns true / false whether a cell is active.
 */
@@ -816,6 +834,13 @@ void field_config_fprintf_config(const field_config_type *config,
 
     if (config->truncation & TRUNCATE_MAX)
         fprintf(stream, CONFIG_FLOAT_OPTION_FORMAT, MAX_KEY, config->max_value);
+
+    if (config->codec != FIELD_CODEC_ZLIB)
+        fprintf(stream, CONFIG_OPTION_FORMAT, COMPRESSION_KEY,
+                field_codec_to_string(config->codec));
+
+    if (config->shuffle)
+        fprintf(stream, CONFIG_OPTION_FORMAT, SHUFFLE_KEY, "True");
 }
 
 UTIL_SAFE_CAST_FUNCTION(field_config, FIELD_CONFIG_ID)
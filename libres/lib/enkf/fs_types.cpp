@@ -16,6 +16,10 @@
    for more details.
 */
 
+#include <string.h>
+
+#include <ert/util/util.hpp>
+
 #include <ert/enkf/fs_types.hpp>
 
 /**
@@ -35,3 +39,19 @@ bool fs_types_valid(fs_driver_enum driver_type) {
     else
         return true;
 }
+
+/**
+  Returns the durability for one of the values "WRITE", "BATCH" and "UMOUNT"
+  of the STORAGE_DURABILITY keyword.
+*/
+bfs_durability_enum fs_types_get_durability(const char *durability) {
+    if (strcmp(durability, "WRITE") == 0)
+        return BFS_DURABILITY_WRITE;
+    if (strcmp(durability, "BATCH") == 0)
+        return BFS_DURABILITY_BATCH;
+    if (strcmp(durability, "UMOUNT") == 0)
+        return BFS_DURABILITY_UMOUNT;
+
+    util_abort("%s: durability:%s not recognized \n", __func__, durability);
+    return BFS_DURABILITY_WRITE;
+}
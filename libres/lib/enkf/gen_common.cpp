@@ -16,9 +16,19 @@
    for more details.
 */
 #include <algorithm>
+#include <charconv>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
 
+#include <ctype.h>
+#include <locale.h>
 #include <stdio.h>
 #include <stdlib.h>
+#ifdef __APPLE__
+#include <xlocale.h>
+#endif
 
 #include <ert/util/util.h>
 
@@ -32,53 +42,168 @@
    by both the gen_data and gen_obs objects.
 */
 
-void *gen_common_fscanf_alloc(const char *file, ecl_data_type load_data_type,
-                              int *size) {
-    FILE *stream = util_fopen(file, "r");
-    int sizeof_ctype = ecl_type_get_sizeof_ctype(load_data_type);
-    int buffer_elements = *size;
-    int current_size = 0;
-    int fscanf_return = 1; /* To keep the compiler happy .*/
-    void *buffer;
+namespace {
+/**
+   The C locale used to convert floating point numbers, so that the decimal
+   separator does not depend on the locale of the process.
+*/
+locale_t gen_common_c_locale() {
+    static const locale_t locale = newlocale(LC_ALL_MASK, "C", (locale_t)0);
+    return locale;
+}
 
-    if (buffer_elements == 0)
-        buffer_elements = 100;
+/**
+   Converts the number at the start of [first, last) and returns a pointer to
+   the first character after it, or first if no number could be converted.
+   Floating point numbers are converted with strtod_l(), which is also what
+   fscanf() uses, as std::from_chars() for floating point types is missing in
+   the older standard libraries we build with. The text must be terminated by
+   a '\0' at last.
+*/
+const char *gen_common_parse_number(const char *first, const char *,
+                                    double *value) {
+    char *next;
+    *value = strtod_l(first, &next, gen_common_c_locale());
+    return next;
+}
 
-    buffer = util_calloc(buffer_elements, sizeof_ctype); // CXX_CAST_ERROR
-    {
-        do {
-            if (ecl_type_is_float(load_data_type)) {
-                float *float_buffer = (float *)buffer;
-                fscanf_return =
-                    fscanf(stream, "%g", &float_buffer[current_size]);
-            } else if (ecl_type_is_double(load_data_type)) {
-                double *double_buffer = (double *)buffer;
-                fscanf_return =
-                    fscanf(stream, "%lg", &double_buffer[current_size]);
-            } else if (ecl_type_is_int(load_data_type)) {
-                int *int_buffer = (int *)buffer;
-                fscanf_return = fscanf(stream, "%d", &int_buffer[current_size]);
-            } else
-                util_abort("%s: god dammit - internal error \n", __func__);
-
-            if (fscanf_return == 1)
-                current_size += 1;
-
-            if (current_size == buffer_elements) {
-                buffer_elements *= 2;
-                buffer = util_realloc(buffer, buffer_elements * sizeof_ctype);
-            }
-        } while (fscanf_return == 1);
+const char *gen_common_parse_number(const char *first, const char *,
+                                    float *value) {
+    char *next;
+    *value = strtof_l(first, &next, gen_common_c_locale());
+    return next;
+}
+
+const char *gen_common_parse_number(const char *first, const char *last,
+                                    int *value) {
+    // fscanf() accepts an explicit plus sign, std::from_chars() does not.
+    const char *number = first;
+    if (*number == '+' && number + 1 != last && number[1] != '-' &&
+        number[1] != '+')
+        number++;
+
+    auto [next, ec] = std::from_chars(number, last, *value);
+    if (ec == std::errc::result_out_of_range)
+        // Like fscanf() an out of range value is not an error.
+        *value = *number == '-' ? std::numeric_limits<int>::min()
+                                : std::numeric_limits<int>::max();
+    else if (ec != std::errc())
+        return first;
+    return next;
+}
+
+/**
+   Parses the numbers of text the way repeated fscanf() calls with a single
+   conversion would: leading whitespace is skipped, and each number is the
+   longest prefix which can be converted. Parsing stops after max_size
+   numbers, at the end of the text or at the first text which is not a
+   number; the offset where parsing stopped is returned in *end.
+*/
+template <typename T>
+std::vector<T> gen_common_parse(const std::string &text, size_t max_size,
+                                size_t *end) {
+    std::vector<T> values;
+    const char *first = text.c_str();
+    const char *last = first + text.size();
+    const char *ptr = first;
+
+    while (values.size() < max_size) {
+        while (ptr != last && isspace(static_cast<unsigned char>(*ptr)))
+            ptr++;
+        if (ptr == last)
+            break;
+
+        T value;
+        const char *next = gen_common_parse_number(ptr, last, &value);
+        if (next == ptr)
+            break;
+
+        values.push_back(value);
+        ptr = next;
     }
-    if (fscanf_return != EOF)
-        util_abort("%s: scanning of %s terminated before EOF was reached -- "
-                   "fix your file.\n",
-                   __func__, file);
+    *end = ptr - first;
+    return values;
+}
 
+std::string gen_common_fread_text(const char *file) {
+    FILE *stream = util_fopen(file, "r");
+    std::string text;
+    char block[1 << 16];
+    size_t read_size;
+    while ((read_size = fread(block, 1, sizeof block, stream)) > 0)
+        text.append(block, read_size);
     fclose(stream);
-    *size = current_size;
+    return text;
+}
+
+/**
+   Aborts unless the text from offset onwards is only whitespace, with the
+   line and column of the first character which could not be parsed.
+*/
+void gen_common_assert_eof(const char *file, std::string_view text,
+                           size_t offset, const char *caller) {
+    size_t pos = offset;
+    while (pos < text.size() && isspace(static_cast<unsigned char>(text[pos])))
+        pos++;
+    if (pos == text.size())
+        return;
+
+    const int line = std::count(text.begin(), text.begin() + pos, '\n') + 1;
+    const size_t line_start = text.rfind('\n', pos);
+    const size_t column =
+        line_start == std::string_view::npos ? pos + 1 : pos - line_start;
+    util_abort("%s: scanning of %s terminated before EOF was reached at line "
+               "%d column %zu -- fix your file.\n",
+               caller, file, line, column);
+}
+
+template <typename T>
+void *gen_common_parse_alloc(const char *file, int *size) {
+    const std::string text = gen_common_fread_text(file);
+    size_t end;
+    const std::vector<T> values =
+        gen_common_parse<T>(text, std::numeric_limits<size_t>::max(), &end);
+    gen_common_assert_eof(file, text, end, "gen_common_fscanf_alloc");
+
+    T *buffer = (T *)util_calloc(std::max<size_t>(values.size(), 1),
+                                 sizeof(T));
+    std::copy(values.begin(), values.end(), buffer);
+    *size = values.size();
     return buffer;
 }
+} // namespace
+
+/**
+   Loads all the numbers in an ASCII file. All the content of the file must be
+   numbers separated by whitespace; otherwise we abort with the position of the
+   offending content.
+
+   The size argument is only used as an output argument.
+*/
+void *gen_common_fscanf_alloc(const char *file, ecl_data_type load_data_type,
+                              int *size) {
+    if (ecl_type_is_float(load_data_type))
+        return gen_common_parse_alloc<float>(file, size);
+    else if (ecl_type_is_double(load_data_type))
+        return gen_common_parse_alloc<double>(file, size);
+    else if (ecl_type_is_int(load_data_type))
+        return gen_common_parse_alloc<int>(file, size);
+
+    util_abort("%s: god dammit - internal error \n", __func__);
+    return NULL;
+}
+
+/**
+   Loads at most max_size integers from the start of an ASCII file, parsing
+   stops at the first content which is not an integer. The caller can check
+   the size of the returned vector.
+*/
+std::vector<int> gen_common_fscanf_int_vector(const char *file,
+                                              size_t max_size) {
+    const std::string text = gen_common_fread_text(file);
+    size_t end;
+    return gen_common_parse<int>(text, max_size, &end);
+}
 
 void *gen_common_fread_alloc(const char *file, ecl_data_type load_data_type,
                              int *size) {
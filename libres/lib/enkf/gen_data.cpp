@@ -263,26 +263,23 @@ static bool gen_data_fload_active__(gen_data_type *gen_data,
             char *active_file = util_alloc_sprintf("%s_active", filename);
             if (fs::exists(active_file)) {
                 file_exists = true;
-                FILE *stream = util_fopen(active_file, "r");
-                int active_int;
+                const std::vector<int> active =
+                    gen_common_fscanf_int_vector(active_file, size);
+                if (active.size() < static_cast<size_t>(size))
+                    util_abort("%s: error when loading active mask from:%s "
+                               "- file not long enough.\n",
+                               __func__, active_file);
+
                 for (int index = 0; index < size; index++) {
-                    if (fscanf(stream, "%d", &active_int) == 1) {
-                        if (active_int == 1)
-                            bool_vector_iset(gen_data->active_mask, index,
-                                             true);
-                        else if (active_int == 0)
-                            bool_vector_iset(gen_data->active_mask, index,
-                                             false);
-                        else
-                            util_abort("%s: error when loading active mask "
-                                       "from:%s only 0 and 1 allowed \n",
-                                       __func__, active_file);
-                    } else
-                        util_abort("%s: error when loading active mask from:%s "
-                                   "- file not long enough.\n",
+                    if (active[index] == 1)
+                        bool_vector_iset(gen_data->active_mask, index, true);
+                    else if (active[index] == 0)
+                        bool_vector_iset(gen_data->active_mask, index, false);
+                    else
+                        util_abort("%s: error when loading active mask "
+                                   "from:%s only 0 and 1 allowed \n",
                                    __func__, active_file);
                 }
-                fclose(stream);
                 logger->info("GEN_DATA({}): active information loaded from:{}.",
                              gen_data_get_key(gen_data), active_file);
             } else
@@ -79,6 +79,8 @@ struct model_config_struct {
     hash_type *runpath_map;
     char *jobname_fmt;
     char *enspath;
+    /** When the cases in enspath fsync() their data to disk. */
+    bfs_durability_enum storage_durability;
     char *rftpath;
     char *data_root;
     char *default_data_root;
@@ -205,6 +207,16 @@ const char *model_config_get_enspath(const model_config_type *model_config) {
     return model_config->enspath;
 }
 
+void model_config_set_storage_durability(model_config_type *model_config,
+                                         bfs_durability_enum durability) {
+    model_config->storage_durability = durability;
+}
+
+bfs_durability_enum
+model_config_get_storage_durability(const model_config_type *model_config) {
+    return model_config->storage_durability;
+}
+
 const ecl_sum_type *
 model_config_get_refcase(const model_config_type *model_config) {
     return model_config->refcase;
@@ -262,6 +274,7 @@ model_config_type *model_config_alloc_empty() {
   */
     UTIL_TYPE_ID_INIT(model_config, MODEL_CONFIG_TYPE_ID);
     model_config->enspath = NULL;
+    model_config->storage_durability = BFS_DURABILITY_WRITE;
     model_config->rftpath = NULL;
     model_config->data_root = NULL;
     model_config->default_data_root = NULL;
@@ -473,6 +486,12 @@ void model_config_init(model_config_type *model_config,
             model_config,
             config_content_get_value_as_abspath(config, ENSPATH_KEY));
 
+    if (config_content_has_item(config, STORAGE_DURABILITY_KEY))
+        model_config_set_storage_durability(
+            model_config,
+            fs_types_get_durability(
+                config_content_get_value(config, STORAGE_DURABILITY_KEY)));
+
     if (config_content_has_item(config, DATA_ROOT_KEY))
         model_config_set_data_root(
             model_config,
@@ -654,6 +673,18 @@ static void model_config_init_user_config(config_parser_type *config) {
     config_add_key_value(config, DATA_ROOT_KEY, false, CONFIG_PATH);
     config_add_key_value(config, ENSPATH_KEY, false, CONFIG_PATH);
 
+    item = config_add_schema_item(config, STORAGE_DURABILITY_KEY, false);
+    config_schema_item_set_argc_minmax(item, 1, 1);
+    {
+        stringlist_type *argv = stringlist_alloc_new();
+        stringlist_append_copy(argv, "WRITE");
+        stringlist_append_copy(argv, "BATCH");
+        stringlist_append_copy(argv, "UMOUNT");
+
+        config_schema_item_set_common_selection_set(item, argv);
+        stringlist_free(argv);
+    }
+
     item = config_add_schema_item(config, JOBNAME_KEY, false);
     config_schema_item_set_argc_minmax(item, 1, 1);
 
@@ -866,12 +866,21 @@ void obs_vector_measure(const obs_vector_type *obs_vector, enkf_fs_type *fs,
 
         node_id_type node_id = {.report_step = report_step, .iens = 0};
 
+        // Block observations of a field only need a few cells of it, these
+        // are loaded without loading the complete field when possible.
+        std::vector<int> active_cells;
+        if (obs_vector->obs_type == BLOCK_OBS)
+            active_cells =
+                block_obs_get_active_cells((const block_obs_type *)obs_node);
+
         int vec_size = ens_active_list.size();
         for (int active_iens_index = 0; active_iens_index < vec_size;
              active_iens_index++) {
             node_id.iens = ens_active_list[active_iens_index];
 
-            enkf_node_load(enkf_node, fs, node_id);
+            if (active_cells.empty() ||
+                !enkf_node_load_cells(enkf_node, fs, node_id, active_cells))
+                enkf_node_load(enkf_node, fs, node_id);
             obs_vector->measure(obs_node, enkf_node_value_ptr(enkf_node),
                                 node_id, meas_data);
         }
@@ -18,8 +18,10 @@
 #include <Eigen/Dense>
 #include <algorithm>
 #include <cmath>
+#include <future>
 #include <numeric>
 #include <stdexcept>
+#include <thread>
 #include <vector>
 
 #include <ert/enkf/row_scaling.hpp>
@@ -33,17 +35,37 @@
 
       X(a) = a*X0 + (1 - a)*I
 
-  for several rows. This grouping is utilized in the row_scaling_multiply()
-  function.
+  for several rows. This grouping is utilized in the RowScaling::multiply()
+  function. The RowScaling::multiply_direct() function does not depend on the
+  grouping, and a RowScaling instance created with clamp == false stores the
+  values as they are assigned.
 */
 
 namespace {
 
+/**
+  The rows sharing an alpha value are gathered from A and multiplied in blocks
+  of at most this many rows, so the temporary copies stay small compared to A.
+*/
+constexpr Eigen::Index ROW_BLOCK_SIZE = 4096;
+
 void scaleX(Eigen::MatrixXd &X, const Eigen::MatrixXd &X0, double alpha) {
-    X = X0;
-    X *= alpha;
-    for (int i = 0; i < X.rows(); i++)
-        X(i, i) = (1 - alpha) + X(i, i);
+    X.noalias() = alpha * X0;
+    X.diagonal().array() += 1 - alpha;
+}
+
+void assert_multiply_size(const RowScaling &row_scaling,
+                          const Eigen::Ref<Eigen::MatrixXd> &A,
+                          const Eigen::MatrixXd &X0) {
+    if (row_scaling.size() != A.rows())
+        throw std::invalid_argument(
+            "Size mismatch between row_scaling and A matrix");
+
+    if (A.cols() != X0.rows())
+        throw std::invalid_argument("Size mismatch between X0 and A matrix");
+
+    if (X0.cols() != X0.rows())
+        throw std::invalid_argument("X0 matrix is not quadratic");
 }
 
 } // namespace
@@ -53,6 +75,8 @@ size_t RowScaling::size() const { return m_data.size(); }
 double RowScaling::operator[](size_t index) const { return m_data.at(index); }
 
 double RowScaling::clamp(double value) const {
+    if (!m_clamp)
+        return value;
     return floor(value * this->m_resolution) / this->m_resolution;
 }
 
@@ -94,21 +118,17 @@ double RowScaling::assign(size_t index, double value) {
   recalculations the row_scaling values are fixed to a finite number of values
   (given by the resolution member in the row_scaling class) and the
   multiplications are grouped together where all rows with the same alpha valued
-  are multiplied in one go.
+  are multiplied in one go: the rows are gathered into a contiguous block, which
+  is multiplied with X(alpha) as one matrix product, and the result is
+  scattered back into A.
  */
 void RowScaling::multiply(Eigen::Ref<Eigen::MatrixXd> A,
                           const Eigen::MatrixXd &X0) const {
-    if (m_data.size() != A.rows())
-        throw std::invalid_argument(
-            "Size mismatch between row_scaling and A matrix");
-
-    if (A.cols() != X0.rows())
-        throw std::invalid_argument("Size mismatch between X0 and A matrix");
+    assert_multiply_size(*this, A, X0);
 
-    if (X0.cols() != X0.rows())
-        throw std::invalid_argument("X0 matrix is not quadratic");
-
-    Eigen::MatrixXd X = Eigen::MatrixXd::Zero(X0.rows(), X0.cols());
+    Eigen::MatrixXd X(X0.rows(), X0.cols());
+    Eigen::MatrixXd block;
+    Eigen::MatrixXd product;
 
     // The sort_index vector is an index permutation corresponding to sorted
     // row_scaling data.
@@ -119,58 +139,90 @@ void RowScaling::multiply(Eigen::Ref<Eigen::MatrixXd> A,
                   return this->operator[](index1) > this->operator[](index2);
               });
 
-    // This is a double while loop where we eventually go through all the rows
-    // in the A matrix / row_scaling vector. In the inner loop we identify a
-    // list of rows which have the same row_scaling value, then we scale the X
-    // matrix according to this shared alpha value and calculate the update.
+    // Go through the rows in order of decreasing alpha; for each range of rows
+    // with the same alpha value scale the X matrix and calculate the update.
     std::size_t index_offset = 0;
-    while (true) {
-        if (index_offset == m_data.size())
+    while (index_offset < m_data.size()) {
+        const double alpha = m_data[sort_index[index_offset]];
+        if (alpha == 0.0)
             break;
 
-        auto end_index = index_offset;
-        auto current_alpha = m_data[sort_index[end_index]];
-        std::vector<int> row_list;
-
         // 1: Identify rows with the same alpha value
-        while (true) {
-            if (end_index == m_data.size())
-                break;
-
-            if (m_data[sort_index[end_index]] != current_alpha)
-                break;
-
-            row_list.push_back(sort_index[end_index]);
+        auto end_index = index_offset;
+        while (end_index < m_data.size() &&
+               m_data[sort_index[end_index]] == alpha)
             end_index += 1;
-        }
-        if (row_list.empty())
-            break;
-
-        double alpha = m_data[row_list[0]];
-        if (alpha == 0.0)
-            break;
 
         // 2: Calculate the scaled X matrix
         scaleX(X, X0, alpha);
 
         // 3: Calculate A' = A * X for the rows with the same alpha
-        for (const auto &row : row_list) {
-            std::vector<double> target_row(A.cols());
-            Eigen::VectorXd src_row = A.row(row);
+        for (auto block_start = index_offset; block_start < end_index;
+             block_start += ROW_BLOCK_SIZE) {
+            const Eigen::Index block_rows = std::min<Eigen::Index>(
+                ROW_BLOCK_SIZE, end_index - block_start);
+            const auto rows =
+                Eigen::Map<const Eigen::VectorXi>(&sort_index[block_start],
+                                                  block_rows);
+
+            block = A(rows, Eigen::all);
+            product.noalias() = block * X;
+            A(rows, Eigen::all) = product;
+        }
 
-            for (int j = 0; j < A.cols(); j++) {
-                target_row[j] = src_row.cwiseProduct(X.col(j)).sum();
-            }
+        index_offset = end_index;
+    }
+}
 
-            if (row < 0 || row >= A.rows())
-                throw std::invalid_argument("Invalid row index");
+/**
+  Since X(alpha) is an affine blend of X0 and the identity, row i of the
+  product A * X(alpha) can be written as
+
+     A'(i,:) = alpha(i) * (A * X0)(i,:) + (1 - alpha(i)) * A(i,:)
 
-            for (int j = 0; j < A.cols(); j++)
-                A(row, j) = target_row.data()[j];
+  i.e. all rows can be calculated from the one shared product A * X0,
+  irrespective of how many different alpha values there are. The product is
+  calculated in blocks of contiguous rows, which are distributed over a pool of
+  worker threads, and every block is blended with its alpha values right after
+  it has been multiplied. Rows with alpha == 0 are left unchanged, the result
+  is otherwise equal to multiply() up to rounding.
+ */
+void RowScaling::multiply_direct(Eigen::Ref<Eigen::MatrixXd> A,
+                                 const Eigen::MatrixXd &X0) const {
+    assert_multiply_size(*this, A, X0);
+
+    const Eigen::Map<const Eigen::ArrayXd> alpha(m_data.data(), m_data.size());
+    const Eigen::Index num_blocks =
+        (A.rows() + ROW_BLOCK_SIZE - 1) / ROW_BLOCK_SIZE;
+    const int num_workers = std::max<int>(
+        1, std::min<Eigen::Index>(std::thread::hardware_concurrency(),
+                                  num_blocks));
+
+    auto multiply_blocks = [&](int first) {
+        Eigen::MatrixXd product;
+        for (Eigen::Index block = first; block < num_blocks;
+             block += num_workers) {
+            const Eigen::Index row_offset = block * ROW_BLOCK_SIZE;
+            const Eigen::Index block_rows =
+                std::min(ROW_BLOCK_SIZE, A.rows() - row_offset);
+            const auto block_alpha = alpha.segment(row_offset, block_rows);
+            auto A_block = A.middleRows(row_offset, block_rows);
+
+            product.noalias() = A_block * X0;
+            A_block.array() =
+                product.array().colwise() * block_alpha +
+                A_block.array().colwise() * (1 - block_alpha);
         }
+    };
 
-        index_offset = end_index;
-    }
+    std::vector<std::future<void>> futures;
+    for (int worker = 1; worker < num_workers; worker++)
+        futures.push_back(
+            std::async(std::launch::async, multiply_blocks, worker));
+    multiply_blocks(0);
+
+    for (auto &fut : futures)
+        fut.get();
 }
 
 void RowScaling::assign_vector(const float *data, size_t size) {
@@ -215,6 +267,19 @@ and use a numpy view:
     # Create a numpy view and invoke the assign_vector() function
     row_scaling.assign_vector(kw_active.numpy_view())
 )";
+const auto multiply_direct_doc = R"(
+Calculate the row scaled update A' = A * X(alpha) in place.
+
+Equivalent to multiply(), but calculated with the closed form
+
+    A * X(alpha) = alpha * (A * X) + (1 - alpha) * A
+
+where the product A * X is calculated once for all rows, in row blocks
+and with several threads. The cost does not depend on the number of
+distinct row scaling values, so this is also the method to use with
+an instance created with clamp=False.
+)";
+
 template <typename T>
 void assign_vector(RowScaling &self, const py::array_t<T> &array) {
     self.assign_vector(array.data(), array.size());
@@ -228,7 +293,7 @@ RES_LIB_SUBMODULE("local.row_scaling", m) {
     opts.disable_function_signatures();
 
     py::class_<RowScaling, std::shared_ptr<RowScaling>>(m, "RowScaling")
-        .def(py::init<>())
+        .def(py::init<bool>(), "clamp"_a = true)
         .def("__len__", &RowScaling::size)
         .def("__setitem__", &setitem, "index"_a, "value"_a)
         .def("__getitem__", &getitem, "index"_a)
@@ -236,5 +301,7 @@ RES_LIB_SUBMODULE("local.row_scaling", m) {
         .def("assign_vector", &assign_vector<float>, py::doc{assign_vector_doc},
              "scaling_vector"_a)
         .def("assign_vector", &assign_vector<double>, "scaling_vector"_a)
-        .def("multiply", &RowScaling::multiply);
+        .def("multiply", &RowScaling::multiply)
+        .def("multiply_direct", &RowScaling::multiply_direct,
+             py::doc{multiply_direct_doc}, "A"_a, "X"_a);
 }
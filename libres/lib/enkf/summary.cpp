@@ -23,6 +23,7 @@
 
 #include <ert/ecl/ecl_sum.h>
 
+#include <ert/enkf/enkf_fs.hpp>
 #include <ert/enkf/enkf_macros.hpp>
 #include <ert/enkf/enkf_serialize.hpp>
 #include <ert/enkf/enkf_types.hpp>
@@ -147,6 +148,35 @@ void summary_user_get_vector(const summary_type *summary, const char *index_key,
     double_vector_memcpy(value, summary->data_vector);
 }
 
+std::vector<double> summary_get_vector(const summary_type *summary) {
+    const double *data = double_vector_get_const_ptr(summary->data_vector);
+    return std::vector<double>(data,
+                               data + double_vector_size(summary->data_vector));
+}
+
+void summary_set_vector(summary_type *summary,
+                        const std::vector<double> &data) {
+    double_vector_set_default(summary->data_vector, SUMMARY_UNDEF);
+    double_vector_memcpy_from_data(summary->data_vector, data.data(),
+                                   data.size());
+}
+
+/**
+   Loads the vector from the summary table of realization iens, see
+   enkf_fs_fread_summary_vector(). Returns false if the vector is not stored
+   in a summary table.
+*/
+bool summary_fread_table_vector(summary_type *summary, enkf_fs_type *fs,
+                                int iens) {
+    std::vector<double> data;
+    if (!enkf_fs_fread_summary_vector(
+            fs, summary_config_get_var(summary->config), iens, data))
+        return false;
+
+    summary_set_vector(summary, data);
+    return true;
+}
+
 /**
    There are three typical reasons why the node data can not be loaded:
 
@@ -276,21 +306,61 @@ bool summary_forward_load_vector(summary_type *summary,
         return loadOK;
 
     int key_index = ecl_sum_get_general_var_params_index(ecl_sum, var_key);
+    const summary_load_plan plan = summary_alloc_load_plan(ecl_sum, time_index);
+    for (size_t step = 0; step < plan.store_index.size(); step++) {
+        double value = ecl_sum_iget(ecl_sum, plan.ministep[step], key_index);
+        double_vector_iset(summary->data_vector, plan.store_index[step], value);
+    }
+    return true;
+}
+
+summary_load_plan summary_alloc_load_plan(const ecl_sum_type *ecl_sum,
+                                          const int_vector_type *time_index) {
+    summary_load_plan plan;
     for (int store_index = 0; store_index < int_vector_size(time_index);
          store_index++) {
         int summary_index = int_vector_iget(time_index, store_index);
 
-        if (summary_index >= 0) {
-            if (ecl_sum_has_report_step(ecl_sum, summary_index)) {
-                int last_update_step_index =
-                    ecl_sum_iget_report_end(ecl_sum, summary_index);
-                double_vector_iset(
-                    summary->data_vector, store_index,
-                    ecl_sum_iget(ecl_sum, last_update_step_index, key_index));
-            }
+        if (summary_index >= 0 &&
+            ecl_sum_has_report_step(ecl_sum, summary_index)) {
+            plan.store_index.push_back(store_index);
+            plan.ministep.push_back(
+                ecl_sum_iget_report_end(ecl_sum, summary_index));
         }
     }
-    return true;
+    return plan;
+}
+
+/**
+   Loads the summary vectors with the given params_index from ecl_sum into the
+   corresponding columns, as summary_forward_load_vector() does for one
+   vector. The ecl_sum data is traversed once, one ministep at a time, and the
+   values of all the keys are picked from each ministep. Elements of the
+   columns which are not in the plan are kept, and columns which are too short
+   are padded with the undefined value.
+*/
+void summary_load_plan_gather(const summary_load_plan &plan,
+                              const ecl_sum_type *ecl_sum,
+                              const std::vector<int> &params_index,
+                              std::vector<std::vector<double>> &columns) {
+    if (columns.size() != params_index.size())
+        util_abort("%s: got %zu columns for %zu keys\n", __func__,
+                   columns.size(), params_index.size());
+    if (plan.store_index.empty())
+        return;
+
+    const size_t size = plan.store_index.back() + 1;
+    for (auto &column : columns)
+        if (column.size() < size)
+            column.resize(size, SUMMARY_UNDEF);
+
+    for (size_t step = 0; step < plan.store_index.size(); step++) {
+        const int store_index = plan.store_index[step];
+        const int ministep = plan.ministep[step];
+        for (size_t key = 0; key < params_index.size(); key++)
+            columns[key][store_index] =
+                ecl_sum_iget(ecl_sum, ministep, params_index[key]);
+    }
 }
 
 UTIL_SAFE_CAST_FUNCTION(summary, SUMMARY)
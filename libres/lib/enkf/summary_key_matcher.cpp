@@ -1,21 +1,46 @@
 #include <ert/enkf/summary_key_matcher.hpp>
 
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include <ert/util/hash.h>
 
 #define SUMMARY_KEY_MATCHER_TYPE_ID 700672137
 
+/** Bound on the number of distinct smspec layouts cached by a matcher. */
+#define SUMMARY_KEY_MATCHER_MAX_LAYOUTS 16
+
+/**
+  The key_set holds all the keys and patterns as they were added, with the
+  required flag as value. The keys are also compiled into a set of exact keys,
+  and the patterns with wildcards grouped on their literal prefix, so a key is
+  only fnmatched against the patterns with a matching prefix.
+*/
 struct summary_key_matcher_struct {
     UTIL_TYPE_ID_DECLARATION;
     hash_type *key_set;
+    std::unordered_set<std::string> exact_keys;
+    std::map<std::string, std::vector<std::string>> patterns;
+
+    /** The selections of summary_key_matcher_match_smspec(), by layout. */
+    mutable std::unordered_map<uint64_t,
+                               std::shared_ptr<const std::vector<bool>>>
+        layouts;
+    mutable std::mutex layout_mutex;
 };
 
 UTIL_IS_INSTANCE_FUNCTION(summary_key_matcher, SUMMARY_KEY_MATCHER_TYPE_ID)
 
 summary_key_matcher_type *summary_key_matcher_alloc() {
-    summary_key_matcher_type *matcher =
-        (summary_key_matcher_type *)util_malloc(sizeof *matcher);
+    summary_key_matcher_type *matcher = new summary_key_matcher_type;
     UTIL_TYPE_ID_INIT(matcher, SUMMARY_KEY_MATCHER_TYPE_ID);
     matcher->key_set = hash_alloc();
     return matcher;
@@ -23,7 +48,7 @@ summary_key_matcher_type *summary_key_matcher_alloc() {
 
 void summary_key_matcher_free(summary_key_matcher_type *matcher) {
     hash_free(matcher->key_set);
-    free(matcher);
+    delete matcher;
 }
 
 int summary_key_matcher_get_size(const summary_key_matcher_type *matcher) {
@@ -35,26 +60,98 @@ void summary_key_matcher_add_summary_key(summary_key_matcher_type *matcher,
     if (!hash_has_key(matcher->key_set, summary_key)) {
         hash_insert_int(matcher->key_set, summary_key,
                         !util_string_has_wildcard(summary_key));
+
+        // Everything util_fnmatch() does not take literally goes into the
+        // patterns, the prefix before it is matched with a string compare.
+        size_t prefix_length = strcspn(summary_key, "*?[\\");
+        if (summary_key[prefix_length] == '\0')
+            matcher->exact_keys.insert(summary_key);
+        else
+            matcher->patterns[std::string(summary_key, prefix_length)]
+                .push_back(summary_key);
+
+        std::lock_guard guard(matcher->layout_mutex);
+        matcher->layouts.clear();
     }
 }
 
 bool summary_key_matcher_match_summary_key(
     const summary_key_matcher_type *matcher, const char *summary_key) {
-    stringlist_type *keys = hash_alloc_stringlist(matcher->key_set);
-    bool has_key = false;
-
-    for (int i = 0; i < stringlist_get_size(keys); i++) {
-        const char *pattern = stringlist_iget(keys, i);
-        if (summary_key)
-            if (util_fnmatch(pattern, summary_key) == 0) {
-                has_key = true;
-                break;
-            }
+    if (!summary_key)
+        return false;
+
+    if (matcher->exact_keys.count(summary_key) > 0)
+        return true;
+
+    for (const auto &[prefix, patterns] : matcher->patterns) {
+        if (strncmp(prefix.c_str(), summary_key, prefix.size()) != 0)
+            continue;
+
+        for (const auto &pattern : patterns)
+            if (util_fnmatch(pattern.c_str(), summary_key) == 0)
+                return true;
     }
+    return false;
+}
 
-    stringlist_free(keys);
+/**
+   A fingerprint of the keys of an smspec instance, in node order; FNV-1a
+   over the keys.
+*/
+static uint64_t
+summary_key_matcher_smspec_layout(const ecl_smspec_type *smspec) {
+    uint64_t hash = 14695981039346656037ULL;
+    auto add_bytes = [&hash](const void *ptr, size_t size) {
+        const unsigned char *bytes = (const unsigned char *)ptr;
+        for (size_t i = 0; i < size; i++) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+    };
+
+    const int num_nodes = ecl_smspec_num_nodes(smspec);
+    add_bytes(&num_nodes, sizeof num_nodes);
+    for (int i = 0; i < num_nodes; i++) {
+        const char *key =
+            ecl_smspec_iget_node_w_node_index(smspec, i).get_gen_key1();
+        // The terminating \0 separates the keys, and stands in for NULL keys
+        add_bytes(key ? key : "", key ? strlen(key) + 1 : 1);
+    }
+    return hash;
+}
+
+/**
+   Matches all the keys of the smspec instance; element i of the returned
+   vector is true if the key of node i is matched.
+
+   The realizations of an ensemble will usually have the same smspec layout,
+   so the selection is cached by layout and only computed for the first
+   realization with a given layout.
+*/
+std::shared_ptr<const std::vector<bool>>
+summary_key_matcher_match_smspec(const summary_key_matcher_type *matcher,
+                                 const ecl_smspec_type *smspec) {
+    const uint64_t layout = summary_key_matcher_smspec_layout(smspec);
+    {
+        std::lock_guard guard(matcher->layout_mutex);
+        auto iter = matcher->layouts.find(layout);
+        if (iter != matcher->layouts.end())
+            return iter->second;
+    }
+
+    const int num_nodes = ecl_smspec_num_nodes(smspec);
+    auto selection = std::make_shared<std::vector<bool>>(num_nodes);
+    for (int i = 0; i < num_nodes; i++) {
+        const char *key =
+            ecl_smspec_iget_node_w_node_index(smspec, i).get_gen_key1();
+        (*selection)[i] = summary_key_matcher_match_summary_key(matcher, key);
+    }
 
-    return has_key;
+    std::lock_guard guard(matcher->layout_mutex);
+    if (matcher->layouts.size() >= SUMMARY_KEY_MATCHER_MAX_LAYOUTS)
+        matcher->layouts.clear();
+    matcher->layouts.emplace(layout, selection);
+    return selection;
 }
 
 stringlist_type *
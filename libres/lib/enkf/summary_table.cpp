@@ -0,0 +1,165 @@
+/*
+   Copyright (C) 2022  Equinor ASA, Norway.
+
+   The file 'summary_table.cpp' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#include <string.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include <ert/enkf/summary_table.hpp>
+
+#define SUMMARY_TABLE_MAGIC_INT 6612094
+#define SUMMARY_TABLE_VERSION 1
+
+namespace {
+int read_int(const char *data, size_t offset) {
+    int value;
+    memcpy(&value, data + offset, sizeof value);
+    return value;
+}
+} // namespace
+
+bool ert::summary_table::has_column(const std::string &key) const {
+    return columns.count(key) > 0;
+}
+
+const std::vector<double> &
+ert::summary_table::get_column(const std::string &key) const {
+    return columns.at(key);
+}
+
+void ert::summary_table::set_column(const std::string &key,
+                                    std::vector<double> data) {
+    auto iter = columns.find(key);
+    if (iter == columns.end()) {
+        keys.push_back(key);
+        columns.emplace(key, std::move(data));
+    } else
+        iter->second = std::move(data);
+}
+
+ert::summary_table::directory ert::summary_table::get_directory() const {
+    directory dir;
+    size_t directory_size = 0;
+    for (size_t index = 0; index < keys.size(); index++) {
+        const auto &key = keys[index];
+        const int length = columns.at(key).size();
+        dir.num_steps = std::max(dir.num_steps, length);
+        dir.columns[key] = {static_cast<int>(index), length};
+        directory_size += 2 * sizeof(int) + key.size();
+    }
+    dir.data_offset = header_size + directory_size;
+    return dir;
+}
+
+void ert::summary_table::fwrite(buffer_type *buffer) const {
+    const directory dir = get_directory();
+
+    buffer_fwrite_int(buffer, SUMMARY_TABLE_MAGIC_INT);
+    buffer_fwrite_int(buffer, SUMMARY_TABLE_VERSION);
+    buffer_fwrite_int(buffer, keys.size());
+    buffer_fwrite_int(buffer, dir.num_steps);
+    buffer_fwrite_int(buffer, dir.data_offset - header_size);
+    for (const auto &key : keys) {
+        buffer_fwrite_int(buffer, key.size());
+        buffer_fwrite(buffer, key.data(), 1, key.size());
+        buffer_fwrite_int(buffer, dir.columns.at(key).length);
+    }
+
+    std::vector<double> column(dir.num_steps, 0);
+    for (const auto &key : keys) {
+        const auto &data = columns.at(key);
+        std::copy(data.begin(), data.end(), column.begin());
+        std::fill(column.begin() + data.size(), column.end(), 0);
+        buffer_fwrite(buffer, column.data(), sizeof(double), column.size());
+    }
+}
+
+/**
+  Returns the size of the key directory, which follows directly after the
+  header_size bytes of the header.
+*/
+size_t ert::summary_table::fread_directory_size(const char *header) {
+    const int magic = read_int(header, 0);
+    const int version = read_int(header, sizeof(int));
+    if (magic != SUMMARY_TABLE_MAGIC_INT || version != SUMMARY_TABLE_VERSION)
+        throw std::runtime_error(
+            fmt::format("Invalid summary table: magic {} version {}", magic,
+                        version));
+    return read_int(header, 4 * sizeof(int));
+}
+
+ert::summary_table::directory
+ert::summary_table::fread_directory(const char *header,
+                                    const char *directory_data) {
+    directory dir;
+    const int num_keys = read_int(header, 2 * sizeof(int));
+    const size_t directory_size = fread_directory_size(header);
+    dir.num_steps = read_int(header, 3 * sizeof(int));
+    dir.data_offset = header_size + directory_size;
+
+    size_t offset = 0;
+    for (int index = 0; index < num_keys; index++) {
+        const int key_length = read_int(directory_data, offset);
+        offset += sizeof(int);
+        std::string key(directory_data + offset, key_length);
+        offset += key_length;
+        const int length = read_int(directory_data, offset);
+        offset += sizeof(int);
+        dir.columns[key] = {index, length};
+    }
+    if (offset != directory_size)
+        throw std::runtime_error("Invalid summary table: corrupt directory");
+    return dir;
+}
+
+ert::summary_table ert::summary_table::fread(buffer_type *buffer) {
+    if (buffer_get_remaining_size(buffer) < header_size)
+        throw std::runtime_error("Invalid summary table: truncated record");
+    const char *header = (const char *)buffer_get_data(buffer) +
+                         buffer_get_offset(buffer);
+    const size_t directory_size = fread_directory_size(header);
+    if (buffer_get_remaining_size(buffer) < header_size + directory_size)
+        throw std::runtime_error("Invalid summary table: truncated record");
+    const directory dir = fread_directory(header, header + header_size);
+
+    if (buffer_get_remaining_size(buffer) <
+        dir.data_offset + sizeof(double) * dir.num_steps * dir.columns.size())
+        throw std::runtime_error("Invalid summary table: truncated record");
+
+    std::vector<std::pair<int, std::string>> ordered;
+    for (const auto &[key, col] : dir.columns)
+        ordered.emplace_back(col.index, key);
+    std::sort(ordered.begin(), ordered.end());
+
+    summary_table table;
+    for (const auto &[index, key] : ordered) {
+        const column &col = dir.columns.at(key);
+        std::vector<double> data(col.length);
+        memcpy(data.data(), header + dir.column_offset(col),
+               sizeof(double) * col.length);
+        table.set_column(key, std::move(data));
+    }
+    buffer_fseek(buffer,
+                 dir.data_offset +
+                     sizeof(double) * dir.num_steps * dir.columns.size(),
+                 SEEK_CUR);
+    return table;
+}
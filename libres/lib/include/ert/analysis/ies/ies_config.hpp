@@ -32,6 +32,7 @@ constexpr const char *IES_MAX_STEPLENGTH_KEY = "IES_MAX_STEPLENGTH";
 constexpr const char *IES_MIN_STEPLENGTH_KEY = "IES_MIN_STEPLENGTH";
 constexpr const char *IES_DEC_STEPLENGTH_KEY = "IES_DEC_STEPLENGTH";
 constexpr const char *IES_DEBUG_KEY = "IES_DEBUG";
+constexpr const char *IES_A0_ON_DISK_KEY = "IES_A0_ON_DISK";
 constexpr const char *ENKF_NCOMP_KEY = "ENKF_NCOMP";
 constexpr const char *INVERSION_KEY = "INVERSION";
 constexpr const char *STRING_INVERSION_EXACT = "EXACT";
@@ -65,6 +66,8 @@ public:
     double max_steplength;
     /** Controlled by config key: DEFAULT_IES_MIN_STEPLENGTH_KEY */
     double min_steplength;
+    /** Controlled by config key: IES_A0_ON_DISK_KEY */
+    bool A0_on_disk = false;
 
 private:
     /** Used for setting threshold of eigen values or number of eigen values */
@@ -2,6 +2,7 @@
 #define IES_DATA_H
 
 #include <Eigen/Dense>
+#include <string>
 #include <vector>
 
 namespace ies {
@@ -9,6 +10,12 @@ namespace ies {
 class Data {
 public:
     Data(int ens_size);
+    ~Data();
+    Data(const Data &) = delete;
+    Data &operator=(const Data &) = delete;
+
+    void set_A0_file(const std::string &path);
+    bool has_A0_file() const;
 
     void update_ens_mask(const std::vector<bool> &mask);
     void store_initial_obs_mask(const std::vector<bool> &mask);
@@ -18,7 +25,7 @@ public:
     const std::vector<bool> &obs_mask() const;
     const std::vector<bool> &ens_mask() const;
 
-    const Eigen::MatrixXd &getA0() const;
+    Eigen::MatrixXd getA0() const;
     const Eigen::MatrixXd &getW() const;
     Eigen::MatrixXd &getW();
     const Eigen::MatrixXd &getE() const;
@@ -33,10 +40,16 @@ public:
     Eigen::MatrixXd make_activeE() const;
     Eigen::MatrixXd make_activeW() const;
     Eigen::MatrixXd make_activeA() const;
+    void multiply_activeA(const Eigen::MatrixXd &X,
+                          Eigen::Ref<Eigen::MatrixXd> A) const;
 
     int iteration_nr = 1;
 
 private:
+    void write_A0_file(const Eigen::MatrixXd &A0);
+    void read_A0_rows(Eigen::Index row_offset, Eigen::Index num_rows,
+                      double *data) const;
+
     bool m_converged = false;
     /** Coefficient matrix used to compute Omega = I + W (I -11'/N)/sqrt(N-1) */
     Eigen::MatrixXd W;
@@ -46,6 +59,12 @@ private:
     std::vector<bool> m_obs_mask{};
     /** Prior ensemble used in Ei=A0 Omega_i */
     Eigen::MatrixXd A0{};
+    /** When set A0 is stored row major in this file instead of in memory */
+    std::string m_A0_file{};
+    int m_A0_fd = -1;
+    bool m_A0_stored = false;
+    Eigen::Index m_A0_rows = 0;
+    Eigen::Index m_A0_cols = 0;
     /** Prior ensemble of measurement perturations (should be the same for all iterations) */
     Eigen::MatrixXd E;
 };
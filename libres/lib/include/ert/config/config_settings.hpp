@@ -49,14 +49,20 @@ bool config_settings_add_setting(config_settings_type *settings,
                                  const char *initial_value);
 void config_settings_add_double_setting(config_settings_type *settings,
                                         const char *key, double initial_value);
+void config_settings_add_int_setting(config_settings_type *settings,
+                                     const char *key, int initial_value);
 
 double
 config_settings_get_double_value(const config_settings_type *config_settings,
                                  const char *key);
+int config_settings_get_int_value(const config_settings_type *config_settings,
+                                  const char *key);
 
 bool config_settings_set_value(const config_settings_type *config_settings,
                                const char *key, const char *value);
 bool config_settings_set_double_value(
     const config_settings_type *config_settings, const char *key, double value);
+bool config_settings_set_int_value(const config_settings_type *config_settings,
+                                   const char *key, int value);
 
 #endif
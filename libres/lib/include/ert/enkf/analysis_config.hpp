@@ -80,6 +80,11 @@ extern "C" void analysis_config_set_std_cutoff(analysis_config_type *config,
                                                double std_cutoff);
 extern "C" double
 analysis_config_get_std_cutoff(const analysis_config_type *config);
+extern "C" void
+analysis_config_set_update_block_size(analysis_config_type *config,
+                                      int block_size);
+extern "C" int
+analysis_config_get_update_block_size(const analysis_config_type *config);
 void analysis_config_add_config_items(config_parser_type *config);
 
 extern "C" bool analysis_config_select_module(analysis_config_type *config,
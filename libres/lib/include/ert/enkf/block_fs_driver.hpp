@@ -22,6 +22,11 @@
 #include <stdbool.h>
 #include <stdio.h>
 
+#include <unordered_map>
+#include <vector>
+
+#include <ert/res_util/block_fs.hpp>
+
 #include <ert/enkf/fs_types.hpp>
 
 typedef struct buffer_struct buffer_type;
@@ -36,6 +41,18 @@ class block_fs_driver {
     bfs_type **fs_list;
 
 public:
+    /**
+      Nodes which are collected with the save_node()/save_vector() overloads
+      and written to storage by commit(), with one write per shard.
+    */
+    class write_batch {
+        friend class block_fs_driver;
+        std::unordered_map<int, std::vector<block_fs_batch_node>> shards;
+
+    public:
+        bool empty() const { return shards.empty(); }
+    };
+
     block_fs_driver(int num_fs);
     ~block_fs_driver();
 
@@ -47,14 +64,36 @@ public:
     bool has_node(const char *node_key, int report_step, int iens);
     void load_node(const char *node_key, int report_step, int iens,
                    buffer_type *buffer);
+    void load_node_range(const char *node_key, int report_step, int iens,
+                         size_t offset, size_t size, void *ptr);
     void save_node(const char *node_key, int report_step, int iens,
                    buffer_type *buffer);
 
     bool has_vector(const char *node_key, int iens);
     void load_vector(const char *node_key, int iens, buffer_type *buffer);
+    void load_vector_range(const char *node_key, int iens, size_t offset,
+                           size_t size, void *ptr);
     void save_vector(const char *node_key, int iens, buffer_type *buffer);
 
+    void save_node(write_batch &batch, const char *node_key, int report_step,
+                   int iens, const buffer_type *buffer);
+    void save_vector(write_batch &batch, const char *node_key, int iens,
+                     const buffer_type *buffer);
+    void commit(write_batch &batch);
+
+    buffer_type *alloc_node_view(const char *node_key, int report_step,
+                                 int iens);
+    buffer_type *alloc_vector_view(const char *node_key, int iens);
+
     void fsync();
+    void suspend_fsync();
+    void resume_fsync();
+    void set_durability(bfs_durability_enum durability);
+    int get_fsync_count() const;
+    long compact();
+
+    int get_num_fs() const { return num_fs; }
+    int get_shard(int iens) const { return iens % num_fs; }
 
 private:
     void mount();
@@ -19,6 +19,8 @@
 #ifndef ERT_BLOCK_OBS_H
 #define ERT_BLOCK_OBS_H
 
+#include <vector>
+
 #include <ert/sched/history.hpp>
 
 #include <ert/config/conf.hpp>
@@ -54,6 +56,7 @@ extern "C" PY_USED int block_obs_iget_i(const block_obs_type *, int index);
 extern "C" PY_USED int block_obs_iget_j(const block_obs_type *, int index);
 extern "C" PY_USED int block_obs_iget_k(const block_obs_type *, int index);
 extern "C" int block_obs_get_size(const block_obs_type *);
+std::vector<int> block_obs_get_active_cells(const block_obs_type *block_obs);
 extern "C" double block_obs_iget_value(const block_obs_type *block_obs,
                                        int index);
 extern "C" double block_obs_iget_std(const block_obs_type *block_obs,
@@ -21,6 +21,7 @@
 
 /* These keys are used as options in KEY:VALUE statements */
 #define BASE_SURFACE_KEY "BASE_SURFACE"
+#define COMPRESSION_KEY "COMPRESSION"
 #define DEFINE_KEY "DEFINE"
 #define DYNAMIC_KEY "DYNAMIC"
 #define ECL_FILE_KEY "ECL_FILE"
@@ -41,6 +42,7 @@
 #define PARAMETER_KEY "PARAMETER"
 #define REPORT_STEPS_KEY "REPORT_STEPS"
 #define RESULT_FILE_KEY "RESULT_FILE"
+#define SHUFFLE_KEY "SHUFFLE"
 #define TEMPLATE_KEY "TEMPLATE"
 #define PRED_KEY "PRED_KEY"
 
@@ -92,6 +94,7 @@
 #define SETENV_KEY "SETENV"
 #define SIMULATION_JOB_KEY "SIMULATION_JOB"
 #define STD_CUTOFF_KEY "STD_CUTOFF"
+#define STORAGE_DURABILITY_KEY "STORAGE_DURABILITY"
 #define SUMMARY_KEY "SUMMARY"
 #define SURFACE_KEY "SURFACE"
 #define UPDATE_LOG_PATH_KEY "UPDATE_LOG_PATH"
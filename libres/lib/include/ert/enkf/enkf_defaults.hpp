@@ -83,6 +83,7 @@
 */
 #define DEFAULT_ENKF_ALPHA 3.0
 #define DEFAULT_ENKF_STD_CUTOFF 1e-6
+#define DEFAULT_UPDATE_BLOCK_SIZE 0 // 0: Update all parameters in one go
 #define DEFAULT_RERUN false
 #define DEFAULT_RERUN_START 0
 #define DEFAULT_UPDATE_LOG_PATH "update_log"
@@ -20,6 +20,8 @@
 #define ERT_ENKF_FS_H
 #include <stdbool.h>
 
+#include <vector>
+
 #include <ert/util/buffer.h>
 #include <ert/util/stringlist.h>
 #include <ert/util/type_macros.h>
@@ -32,9 +34,10 @@
 #include <ert/enkf/misfit_ensemble_typedef.hpp>
 #include <ert/enkf/state_map.hpp>
 #include <ert/enkf/summary_key_set.hpp>
+#include <ert/enkf/summary_table.hpp>
 #include <ert/enkf/time_map.hpp>
 
-const char *enkf_fs_get_mount_point(const enkf_fs_type *fs);
+extern "C" const char *enkf_fs_get_mount_point(const enkf_fs_type *fs);
 extern "C" const char *enkf_fs_get_case_name(const enkf_fs_type *fs);
 extern "C" bool enkf_fs_is_read_only(const enkf_fs_type *fs);
 extern "C" void enkf_fs_fsync(enkf_fs_type *fs);
@@ -56,18 +59,58 @@ void enkf_fs_fwrite_vector(enkf_fs_type *enkf_fs, buffer_type *buffer,
                            const char *node_key, enkf_var_type var_type,
                            int iens);
 
+extern "C" PY_USED long enkf_fs_compact(enkf_fs_type *fs);
+
+bool enkf_fs_fread_summary_vector(enkf_fs_type *fs, const char *key, int iens,
+                                  std::vector<double> &data);
+ert::summary_table enkf_fs_fread_summary_table(enkf_fs_type *fs, int iens);
+void enkf_fs_fwrite_summary_table(enkf_fs_type *fs,
+                                  const ert::summary_table &table, int iens);
+extern "C" PY_USED int enkf_fs_migrate_summary(enkf_fs_type *fs);
+extern "C" PY_USED void enkf_fs_set_durability(enkf_fs_type *fs,
+                                               bfs_durability_enum durability);
+
+enkf_fs_batch_type *enkf_fs_batch_alloc(enkf_fs_type *fs);
+void enkf_fs_batch_free(enkf_fs_batch_type *batch);
+void enkf_fs_batch_fwrite_node(enkf_fs_batch_type *batch,
+                               const buffer_type *buffer, const char *node_key,
+                               enkf_var_type var_type, int report_step,
+                               int iens);
+void enkf_fs_batch_fwrite_vector(enkf_fs_batch_type *batch,
+                                 const buffer_type *buffer,
+                                 const char *node_key, enkf_var_type var_type,
+                                 int iens);
+void enkf_fs_batch_commit(enkf_fs_batch_type *batch);
+
 extern "C" bool enkf_fs_exists(const char *mount_point);
 
+int enkf_fs_get_parameter_num_shards(const enkf_fs_type *fs);
+int enkf_fs_get_parameter_shard(const enkf_fs_type *fs, int iens);
+void enkf_fs_suspend_parameter_fsync(enkf_fs_type *fs);
+void enkf_fs_resume_parameter_fsync(enkf_fs_type *fs);
+
 extern "C" void enkf_fs_sync(enkf_fs_type *fs);
 
 void enkf_fs_fread_node(enkf_fs_type *enkf_fs, buffer_type *buffer,
                         const char *node_key, enkf_var_type var_type,
                         int report_step, int iens);
+void enkf_fs_fread_node_range(enkf_fs_type *enkf_fs, const char *node_key,
+                              enkf_var_type var_type, int report_step,
+                              int iens, size_t offset, size_t size,
+                              void *ptr);
 
 void enkf_fs_fread_vector(enkf_fs_type *enkf_fs, buffer_type *buffer,
                           const char *node_key, enkf_var_type var_type,
                           int iens);
 
+buffer_type *enkf_fs_alloc_node_view(enkf_fs_type *enkf_fs,
+                                     const char *node_key,
+                                     enkf_var_type var_type, int report_step,
+                                     int iens);
+buffer_type *enkf_fs_alloc_vector_view(enkf_fs_type *enkf_fs,
+                                       const char *node_key,
+                                       enkf_var_type var_type, int iens);
+
 bool enkf_fs_has_vector(enkf_fs_type *enkf_fs, const char *node_key,
                         enkf_var_type var_type, int iens);
 bool enkf_fs_has_node(enkf_fs_type *enkf_fs, const char *node_key,
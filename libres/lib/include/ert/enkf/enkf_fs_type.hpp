@@ -19,4 +19,5 @@
 #ifndef ERT_ENKF_FS_TYPES_H
 #define ERT_ENKF_FS_TYPES_H
 typedef struct enkf_fs_struct enkf_fs_type;
+typedef struct enkf_fs_batch_struct enkf_fs_batch_type;
 #endif
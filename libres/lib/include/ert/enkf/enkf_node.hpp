@@ -22,6 +22,8 @@
 #include <stdbool.h>
 #include <stdlib.h>
 
+#include <vector>
+
 #include <ert/util/buffer.h>
 #include <ert/util/hash.h>
 #include <ert/util/int_vector.h>
@@ -144,12 +146,17 @@ enkf_node_type *enkf_node_load_alloc(const enkf_config_node_type *config_node,
 bool enkf_node_fload(enkf_node_type *enkf_node, const char *filename);
 void enkf_node_load(enkf_node_type *enkf_node, enkf_fs_type *fs,
                     node_id_type node_id);
+bool enkf_node_load_cells(enkf_node_type *enkf_node, enkf_fs_type *fs,
+                          node_id_type node_id,
+                          const std::vector<int> &active_index);
 void enkf_node_load_vector(enkf_node_type *enkf_node, enkf_fs_type *fs,
                            int iens);
 extern "C" bool enkf_node_store(enkf_node_type *enkf_node, enkf_fs_type *fs,
                                 node_id_type node_id);
 bool enkf_node_store_vector(enkf_node_type *enkf_node, enkf_fs_type *fs,
                             int iens);
+bool enkf_node_store_batch(enkf_node_type *enkf_node, enkf_fs_batch_type *batch,
+                           node_id_type node_id);
 extern "C" bool enkf_node_try_load(enkf_node_type *enkf_node, enkf_fs_type *fs,
                                    node_id_type node_id);
 bool enkf_node_try_load_vector(enkf_node_type *enkf_node, enkf_fs_type *fs,
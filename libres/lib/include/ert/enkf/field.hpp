@@ -18,12 +18,15 @@
 
 #ifndef ERT_FIELD_H
 #define ERT_FIELD_H
+#include <vector>
+
 #include <ert/util/type_macros.h>
 
 #include <ert/ecl/ecl_kw.h>
 #include <ert/ecl/ecl_type.h>
 #include <ert/ecl/fortio.h>
 
+#include <ert/enkf/enkf_fs_type.hpp>
 #include <ert/enkf/enkf_macros.hpp>
 #include <ert/enkf/enkf_serialize.hpp>
 #include <ert/enkf/enkf_util.hpp>
@@ -43,6 +46,9 @@ void field_ROFF_export(const field_type *, const char *, const char *);
 void field_copy_ecl_kw_data(field_type *, const ecl_kw_type *);
 extern "C" void field_free(field_type *);
 bool field_fload_keep_inactive(field_type *field, const char *filename);
+bool field_load_cells(field_type *field, enkf_fs_type *fs, const char *key,
+                      enkf_var_type var_type, node_id_type node_id,
+                      const std::vector<int> &active_index);
 bool field_fload_rms(field_type *field, const char *filename,
                      bool keep_inactive);
 void field_export3D(const field_type *, void *, bool, ecl_data_type, void *,
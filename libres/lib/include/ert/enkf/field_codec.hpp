@@ -0,0 +1,85 @@
+/*
+   Copyright (C) 2022  Equinor ASA, Norway.
+
+   The file 'field_codec.hpp' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#ifndef ERT_FIELD_CODEC_H
+#define ERT_FIELD_CODEC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include <ert/util/buffer.h>
+
+/** How the data of a FIELD is compressed when it is stored in enkf_fs. */
+typedef enum {
+    FIELD_CODEC_NONE = 0,
+    FIELD_CODEC_LZ4 = 1,
+    FIELD_CODEC_ZLIB = 2
+} field_codec_enum;
+
+#define FIELD_CODEC_NONE_STRING "NONE"
+#define FIELD_CODEC_LZ4_STRING "LZ4"
+#define FIELD_CODEC_ZLIB_STRING "ZLIB"
+
+/**
+  The size of the uncompressed data in each of the independently compressed
+  chunks of a stored field.
+*/
+#define FIELD_CODEC_CHUNK_SIZE (64 * 1024)
+
+/** The size of the fixed part of the header, see field_codec.cpp. */
+#define FIELD_CODEC_HEADER_SIZE (4 * sizeof(int) + sizeof(int64_t))
+
+/**
+  The layout of a stored field: the data is split in chunks which are
+  compressed independently, so some cells can be read without reading and
+  decompressing the whole field.
+*/
+struct field_codec_layout {
+    field_codec_enum codec;
+    /** The element size the bytes are shuffled with, 0 if not shuffled. */
+    int shuffle_size;
+    /** The uncompressed size of all the chunks except the last. */
+    size_t chunk_size;
+    /**
+      The offsets of the chunks relative to the start of the header; the last
+      element is the end of the last chunk.
+    */
+    std::vector<size_t> chunk_offsets;
+
+    int num_chunks() const { return chunk_offsets.size() - 1; }
+};
+
+bool field_codec_from_string(const char *codec_string, field_codec_enum *codec);
+const char *field_codec_to_string(field_codec_enum codec);
+
+void field_codec_fwrite(buffer_type *buffer, const void *data,
+                        size_t byte_size, int element_size,
+                        field_codec_enum codec, bool shuffle);
+void field_codec_fread(buffer_type *buffer, void *data, size_t byte_size);
+
+bool field_codec_fread_header(const char *header, field_codec_layout *layout);
+size_t field_codec_chunk_index_size(const field_codec_layout &layout);
+void field_codec_fread_chunk_index(const char *chunk_index,
+                                   field_codec_layout *layout);
+void field_codec_decode_chunk(const field_codec_layout &layout, int chunk,
+                              const char *compressed, void *data,
+                              size_t byte_size);
+
+#endif
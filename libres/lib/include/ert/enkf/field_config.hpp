@@ -35,6 +35,7 @@
 #include <ert/enkf/enkf_macros.hpp>
 #include <ert/enkf/enkf_types.hpp>
 #include <ert/enkf/enkf_util.hpp>
+#include <ert/enkf/field_codec.hpp>
 #include <ert/enkf/field_common.hpp>
 #include <ert/enkf/field_trans.hpp>
 
@@ -127,6 +128,10 @@ field_config_get_data_size_from_grid(const field_config_type *config);
 void field_config_set_ecl_data_type(field_config_type *, ecl_data_type);
 int field_config_get_byte_size(const field_config_type *);
 int field_config_get_sizeof_ctype(const field_config_type *);
+void field_config_set_codec(field_config_type *config, field_codec_enum codec,
+                            bool shuffle);
+field_codec_enum field_config_get_codec(const field_config_type *config);
+bool field_config_get_shuffle(const field_config_type *config);
 int field_config_active_index(const field_config_type *, int, int, int);
 int field_config_global_index(const field_config_type *, int, int, int);
 bool field_config_ijk_valid(const field_config_type *, int, int, int);
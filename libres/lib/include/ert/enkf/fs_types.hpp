@@ -50,6 +50,21 @@ typedef enum {
     DRIVER_DYNAMIC_ANALYZED = 6
 } fs_driver_enum;
 
+/**
+  When the data written to the block_fs drivers is fsync()'ed to disk. Writes
+  which are collected in a write batch are always fsync()'ed with one call
+  when the batch is committed, unless the durability is BFS_DURABILITY_UMOUNT.
+*/
+typedef enum {
+    /** fsync() for every 10th write - this is the default. */
+    BFS_DURABILITY_WRITE = 0,
+    /** fsync() only when a write batch is committed. */
+    BFS_DURABILITY_BATCH = 1,
+    /** fsync() only when the filesystem is unmounted. */
+    BFS_DURABILITY_UMOUNT = 2
+} bfs_durability_enum;
+
 bool fs_types_valid(fs_driver_enum driver_type);
+bfs_durability_enum fs_types_get_durability(const char *durability);
 
 #endif
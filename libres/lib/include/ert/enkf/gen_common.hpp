@@ -22,10 +22,14 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <vector>
+
 #include <ert/ecl/ecl_type.h>
 #include <ert/enkf/gen_data_config.hpp>
 
 void *gen_common_fscanf_alloc(const char *, ecl_data_type, int *);
+std::vector<int> gen_common_fscanf_int_vector(const char *file,
+                                              size_t max_size);
 void *gen_common_fread_alloc(const char *, ecl_data_type, int *);
 void *gen_common_fload_alloc(const char *, gen_data_file_format_type,
                              ecl_data_type, ecl_type_enum *, int *);
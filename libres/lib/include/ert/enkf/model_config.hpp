@@ -59,6 +59,11 @@ void model_config_set_rftpath(model_config_type *model_config,
                               const char *rftpath);
 extern "C" const char *
 model_config_get_enspath(const model_config_type *model_config);
+extern "C" PY_USED void
+model_config_set_storage_durability(model_config_type *model_config,
+                                    bfs_durability_enum durability);
+extern "C" PY_USED bfs_durability_enum
+model_config_get_storage_durability(const model_config_type *model_config);
 const ecl_sum_type *
 model_config_get_refcase(const model_config_type *model_config);
 bool model_config_has_prediction(const model_config_type *);
@@ -5,16 +5,22 @@
 
 class RowScaling : public std::enable_shared_from_this<RowScaling> {
     size_t m_resolution = 1000;
+    bool m_clamp = true;
     std::vector<double> m_data;
 
     void m_resize(size_t new_size);
 
 public:
+    RowScaling() = default;
+    explicit RowScaling(bool clamp) : m_clamp(clamp) {}
+
     double operator[](size_t index) const;
     double assign(size_t index, double value);
     double clamp(double value) const;
     void multiply(Eigen::Ref<Eigen::MatrixXd> A,
                   const Eigen::MatrixXd &X0) const;
+    void multiply_direct(Eigen::Ref<Eigen::MatrixXd> A,
+                         const Eigen::MatrixXd &X0) const;
     size_t size() const;
 
     void assign_vector(const float *data, size_t size);
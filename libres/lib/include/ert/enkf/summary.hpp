@@ -18,7 +18,10 @@
 
 #ifndef ERT_SUMMARY_H
 #define ERT_SUMMARY_H
+#include <vector>
+
 #include <ert/util/double_vector.h>
+#include <ert/util/int_vector.h>
 
 #include <ert/ecl/ecl_file.h>
 #include <ert/ecl/ecl_sum.h>
@@ -36,6 +39,29 @@ extern "C" void summary_set(summary_type *summary, int report_step,
 bool summary_active_value(double value);
 extern "C" int summary_length(const summary_type *summary);
 extern "C" double summary_undefined_value();
+std::vector<double> summary_get_vector(const summary_type *summary);
+void summary_set_vector(summary_type *summary, const std::vector<double> &data);
+bool summary_fread_table_vector(summary_type *summary, enkf_fs_type *fs,
+                                int iens);
+
+/**
+  The ministeps of an ecl_sum instance which are loaded into the stored
+  summary steps. The mapping is the same for all the summary keys of a
+  realization, so it is resolved once and used for all the keys.
+*/
+struct summary_load_plan {
+    /** The stored steps which have data, in increasing order. */
+    std::vector<int> store_index;
+    /** The last ministep of the report step loaded into store_index[i]. */
+    std::vector<int> ministep;
+};
+
+summary_load_plan summary_alloc_load_plan(const ecl_sum_type *ecl_sum,
+                                          const int_vector_type *time_index);
+void summary_load_plan_gather(const summary_load_plan &plan,
+                              const ecl_sum_type *ecl_sum,
+                              const std::vector<int> &params_index,
+                              std::vector<std::vector<double>> &columns);
 
 VOID_HAS_DATA_HEADER(summary);
 UTIL_SAFE_CAST_HEADER(summary);
@@ -1,9 +1,14 @@
 #ifndef ERT_SUMMARY_KEY_MATCHER_H
 #define ERT_SUMMARY_KEY_MATCHER_H
 
+#include <memory>
+#include <vector>
+
 #include <ert/util/stringlist.h>
 #include <ert/util/type_macros.h>
 
+#include <ert/ecl/ecl_smspec.hpp>
+
 #include <ert/enkf/enkf_types.hpp>
 
 typedef struct summary_key_matcher_struct summary_key_matcher_type;
@@ -18,6 +23,9 @@ summary_key_matcher_add_summary_key(summary_key_matcher_type *matcher,
 extern "C" bool
 summary_key_matcher_match_summary_key(const summary_key_matcher_type *matcher,
                                       const char *summary_key);
+std::shared_ptr<const std::vector<bool>>
+summary_key_matcher_match_smspec(const summary_key_matcher_type *matcher,
+                                 const ecl_smspec_type *smspec);
 extern "C" bool summary_key_matcher_summary_key_is_required(
     const summary_key_matcher_type *matcher, const char *summary_key);
 extern "C" stringlist_type *
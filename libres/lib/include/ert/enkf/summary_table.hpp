@@ -0,0 +1,93 @@
+/*
+   Copyright (C) 2022  Equinor ASA, Norway.
+
+   The file 'summary_table.hpp' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#ifndef ERT_SUMMARY_TABLE_H
+#define ERT_SUMMARY_TABLE_H
+
+#include <stddef.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <ert/util/buffer.h>
+
+namespace ert {
+
+/**
+  All the summary vectors of one realization, which are stored as one record
+  in the dynamic_forecast storage instead of one record per summary key.
+
+  The vectors are the columns of a (time x key) matrix which is stored column
+  major, i.e. one summary vector is one contiguous slice of the record:
+
+    |<magic: Int><version: Int><num_keys: Int><num_steps: Int><directory_size: Int>|
+    |<directory: num_keys x <key_length: Int><key: Char[key_length]><length: Int>>|
+    |<data: num_keys x num_steps x Double>|
+
+  The length is the number of steps which have been stored for the key, the
+  elements beyond the length of a column are padding.
+*/
+class summary_table {
+public:
+    /** The position of one summary vector in a stored table. */
+    struct column {
+        int index;
+        int length;
+    };
+
+    /**
+      The key directory of a stored table; this is sufficient to read one
+      column from the storage without reading the whole table.
+    */
+    struct directory {
+        int num_steps = 0;
+        /** The offset of the data block from the start of the record. */
+        size_t data_offset = 0;
+        std::unordered_map<std::string, column> columns;
+
+        size_t column_offset(const column &col) const {
+            return data_offset + sizeof(double) * col.index * num_steps;
+        }
+    };
+
+    /** The size in bytes of the fixed size header of the record. */
+    static constexpr size_t header_size = 5 * sizeof(int);
+
+    bool has_column(const std::string &key) const;
+    const std::vector<double> &get_column(const std::string &key) const;
+    void set_column(const std::string &key, std::vector<double> data);
+    int size() const { return keys.size(); }
+
+    directory get_directory() const;
+    void fwrite(buffer_type *buffer) const;
+    static summary_table fread(buffer_type *buffer);
+
+    static size_t fread_directory_size(const char *header);
+    static directory fread_directory(const char *header,
+                                     const char *directory_data);
+
+private:
+    /** The keys in the order they were added, i.e. the column order. */
+    std::vector<std::string> keys;
+    std::unordered_map<std::string, std::vector<double>> columns;
+};
+
+} // namespace ert
+
+#endif
@@ -21,6 +21,8 @@
 
 #include <ert/job_queue/queue_driver.hpp>
 
+#define LOCAL_MAX_CORES "MAX_CORES"
+
 typedef struct local_driver_struct local_driver_type;
 
 void *local_driver_alloc();
@@ -33,6 +35,10 @@ void local_driver_kill_job(void *__driver, void *__job);
 void local_driver_free__(void *__driver);
 job_status_type local_driver_get_job_status(void *__driver, void *__job);
 void local_driver_free_job(void *__job);
+bool local_driver_set_option(void *__driver, const char *option_key,
+                             const void *value_);
+const void *local_driver_get_option(const void *__driver,
+                                    const char *option_key);
 void local_driver_init_option_list(stringlist_type *option_list);
 
 #endif
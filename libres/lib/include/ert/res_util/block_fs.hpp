@@ -19,6 +19,8 @@
 #ifndef ERT_BLOCK_FS
 #define ERT_BLOCK_FS
 #include <filesystem>
+#include <string>
+#include <vector>
 
 #include <ert/util/buffer.hpp>
 #include <ert/util/type_macros.hpp>
@@ -27,7 +29,15 @@
 typedef struct block_fs_struct block_fs_type;
 typedef struct user_file_node_struct user_file_node_type;
 
+/** One of the nodes written by block_fs_fwrite_batch(). */
+struct block_fs_batch_node {
+    std::string filename;
+    std::vector<char> data;
+};
+
 void block_fs_fsync(block_fs_type *block_fs);
+void block_fs_set_fsync_interval(block_fs_type *block_fs, int fsync_interval);
+int block_fs_get_fsync_count(const block_fs_type *block_fs);
 bool block_fs_is_readonly(const block_fs_type *block_fs);
 block_fs_type *block_fs_mount(const std::filesystem::path &mount_file,
                               int block_size, int fsync_interval,
@@ -37,9 +47,17 @@ void block_fs_fwrite_file(block_fs_type *block_fs, const char *filename,
                           const void *ptr, size_t byte_size);
 void block_fs_fwrite_buffer(block_fs_type *block_fs, const char *filename,
                             const buffer_type *buffer);
+void block_fs_fwrite_batch(block_fs_type *block_fs,
+                           const std::vector<block_fs_batch_node> &nodes,
+                           bool sync);
 void block_fs_fread_realloc_buffer(block_fs_type *block_fs,
                                    const char *filename, buffer_type *buffer);
+void block_fs_fread_range(block_fs_type *block_fs, const char *filename,
+                          size_t offset, size_t size, void *ptr);
+bool block_fs_fread_view(block_fs_type *block_fs, const char *filename,
+                         const void **data, size_t *size);
 bool block_fs_has_file(block_fs_type *block_fs, const char *filename);
+long block_fs_compact(block_fs_type *block_fs);
 
 UTIL_IS_INSTANCE_HEADER(block_fs);
 UTIL_SAFE_CAST_HEADER(block_fs);
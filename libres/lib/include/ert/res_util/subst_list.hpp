@@ -22,6 +22,9 @@
 #include <stdbool.h>
 #include <stdio.h>
 
+#include <utility>
+#include <vector>
+
 #include <ert/util/buffer.hpp>
 #include <ert/util/type_macros.hpp>
 
@@ -64,6 +67,10 @@ extern "C" const char *
 subst_list_get_doc_string(const subst_list_type *subst_list, const char *key);
 extern "C" bool subst_list_has_key(const subst_list_type *subst_list,
                                    const char *key);
+void subst_list_get_substitutions(
+    const subst_list_type *subst_list,
+    std::vector<std::pair<const char *, const char *>> &strings,
+    std::vector<const char *> &func_names);
 void subst_list_add_from_string(subst_list_type *subst_list,
                                 const char *arg_string, bool append);
 
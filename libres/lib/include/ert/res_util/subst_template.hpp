@@ -0,0 +1,66 @@
+#ifndef ERT_SUBST_TEMPLATE_H
+#define ERT_SUBST_TEMPLATE_H
+
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <ert/res_util/subst_list.hpp>
+
+namespace ert {
+
+/**
+   A template text compiled for substitution with subst_list instances.
+
+   subst_list_update_buffer() scans the whole text once for every key. The
+   subst_template instead scans the text once for all the keys together,
+   and splits it into literal segments and key slots. Instantiating the
+   template is then a single pass which writes the segments and the values
+   of the slots.
+
+   The compiled plan only depends on the keys, not on the values, so it is
+   reused for as long as the keys stay the same - e.g. for all the
+   realizations of an ensemble.
+
+   Templates read from file with subst_template::load() are kept in a
+   process wide cache, so each template file is read and compiled once and
+   then shared by all the realizations. The cache is emptied with
+   subst_template::clear_cache() when the runpaths have been created.
+
+   The result is always the same as applying subst_list_update_buffer() with
+   each of the subst_lists in turn. When the single pass can not guarantee
+   that, instantiate() falls back to subst_list_update_buffer(). This is the
+   case when:
+
+    1. Occurrences of the keys overlap in the text.
+
+    2. The text contains a function call, e.g. __EXP__(...).
+
+    3. An inserted value can give a new occurrence of a key or function
+       name, e.g. cascading substitutions like ("<PATH>", "/tmp/<CASE>").
+*/
+class subst_template {
+public:
+    explicit subst_template(std::string text);
+    static std::shared_ptr<const subst_template>
+    load(const std::filesystem::path &path);
+    static void clear_cache();
+
+    const std::string &text() const { return m_text; }
+    bool instantiate(const std::vector<const subst_list_type *> &subst_lists,
+                     std::string &result) const;
+
+private:
+    struct plan;
+    std::shared_ptr<const plan>
+    get_plan(const std::vector<std::string> &patterns, int num_keys) const;
+
+    std::string m_text;
+    mutable std::mutex m_plan_lock;
+    mutable std::shared_ptr<const plan> m_plan;
+};
+
+} // namespace ert
+#endif
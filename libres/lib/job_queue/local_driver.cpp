@@ -16,112 +16,365 @@
    for more details.
 */
 
+#include <algorithm>
+#include <deque>
 #include <mutex>
 #include <optional>
+#include <string>
 #include <thread>
+#include <vector>
 
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
 #include <signal.h>
 #include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
 #include <sys/wait.h>
+#include <unistd.h>
 
 #include <ert/util/util.hpp>
 
+#include <ert/logging.hpp>
+
 #include <ert/job_queue/local_driver.hpp>
 #include <ert/job_queue/queue_driver.hpp>
 
+static auto logger = ert::get_logger("job_queue.local_driver");
+
+/*
+  The local driver runs the jobs as child processes of the current process.
+
+  All the children are reaped by one thread per driver, the reaper. The
+  reaper waits in poll() on a pidfd for each running child, and on a pipe
+  which is written to when there is something new for it to do. If the
+  kernel does not support pidfd_open() the reaper instead polls the
+  children with a short timeout. The children are reaped individually with
+  wait4() - the driver never waits for other children of the process,
+  which typically belong to Python.
+
+  The reaper is also the scheduler: When the MAX_CORES option is set the
+  jobs are started in submit order when there are enough free cores for
+  them, where a job uses num_cpu of the MAX_CORES cores. A job which needs
+  more cores than MAX_CORES is started when no other jobs are running.
+  Without MAX_CORES the jobs are started immediately.
+*/
+
+/** How often children are polled when pidfd_open() is not available. */
+#define LOCAL_DRIVER_POLL_INTERVAL_MS 100
+
 typedef struct local_job_struct local_job_type;
 
 struct local_job_struct {
-    bool active;
+    /** NULL after the driver has been freed. */
+    local_driver_type *driver;
     job_status_type status;
-    std::optional<std::thread> run_thread;
+    std::string executable;
+    std::vector<std::string> argv;
+    int num_cpu;
+    /** The number of cores used by the job while it is running. */
+    int cores;
     pid_t child_process;
+    int pidfd;
+    /** Set when local_driver_free_job() is called while the driver still
+     * holds the job; the job is then deleted when it is done. */
+    bool freed;
+    struct rusage rusage;
 };
 
 struct local_driver_struct {
-    std::mutex submit_lock;
+    std::mutex lock;
+    /** The number of cores the jobs can use; 0 means no limit. */
+    int max_cores;
+    std::string max_cores_string;
+    int used_cores;
+    std::deque<local_job_type *> pending_jobs;
+    std::vector<local_job_type *> running_jobs;
+    std::optional<std::thread> reaper;
+    bool stop;
+    int wakeup_pipe[2];
 };
 
-static local_job_type *local_job_alloc() {
+static local_job_type *local_job_alloc(local_driver_type *driver,
+                                       const char *executable, int num_cpu,
+                                       int argc, const char **argv) {
     local_job_type *job = new local_job_type;
-    job->active = false;
-    job->status = JOB_QUEUE_WAITING;
+    job->driver = driver;
+    job->status = JOB_QUEUE_PENDING;
+    job->executable = executable;
+    job->argv.assign(argv, argv + argc);
+    job->num_cpu = std::max(num_cpu, 1);
+    job->cores = 0;
+    job->child_process = 0;
+    job->pidfd = -1;
+    job->freed = false;
     return job;
 }
 
+static int local_driver_pidfd_open(pid_t pid) {
+#ifdef SYS_pidfd_open
+    return syscall(SYS_pidfd_open, pid, 0);
+#else
+    return -1;
+#endif
+}
+
+static double local_driver_get_seconds(const struct timeval &time) {
+    return time.tv_sec + time.tv_usec * 1e-6;
+}
+
+static void local_driver_wakeup(local_driver_type *driver) {
+    char byte = 0;
+    if (write(driver->wakeup_pipe[1], &byte, 1) < 0 && errno != EAGAIN)
+        logger->error("Failed to wake up the local driver: {}",
+                      strerror(errno));
+}
+
+/** Starts pending jobs while there are free cores; called with the lock. */
+static void local_driver_start_jobs(local_driver_type *driver) {
+    while (!driver->pending_jobs.empty()) {
+        local_job_type *job = driver->pending_jobs.front();
+        int cores = job->num_cpu;
+        if (driver->max_cores > 0) {
+            cores = std::min(cores, driver->max_cores);
+            if (driver->used_cores > 0 &&
+                driver->used_cores + cores > driver->max_cores)
+                break;
+        }
+
+        std::vector<const char *> argv;
+        for (const auto &arg : job->argv)
+            argv.push_back(arg.c_str());
+        job->child_process = util_spawn(job->executable.c_str(), argv.size(),
+                                        argv.data(), NULL, NULL);
+        job->pidfd = local_driver_pidfd_open(job->child_process);
+        job->status = JOB_QUEUE_RUNNING;
+        job->cores = cores;
+        driver->used_cores += cores;
+        driver->pending_jobs.pop_front();
+        driver->running_jobs.push_back(job);
+    }
+}
+
+/**
+  Reaps the running jobs which have exited; called with the lock. The
+  rusage of the child is kept with the job and logged.
+*/
+static void local_driver_reap_jobs(local_driver_type *driver) {
+    auto job_iter = driver->running_jobs.begin();
+    while (job_iter != driver->running_jobs.end()) {
+        local_job_type *job = *job_iter;
+        int wait_status = 0;
+        pid_t pid =
+            wait4(job->child_process, &wait_status, WNOHANG, &job->rusage);
+        if (pid == 0 || (pid < 0 && errno == EINTR)) {
+            ++job_iter;
+            continue;
+        }
+
+        job->status = JOB_QUEUE_EXIT;
+        if (pid < 0) {
+            // Typically ECHILD: the child has been reaped by someone else,
+            // and its exit status is lost.
+            logger->error("Failed to wait for process {}: {}",
+                          job->child_process, strerror(errno));
+            memset(&job->rusage, 0, sizeof job->rusage);
+        } else if (WIFEXITED(wait_status) && WEXITSTATUS(wait_status) == 0)
+            job->status = JOB_QUEUE_DONE;
+        if (job->pidfd >= 0)
+            close(job->pidfd);
+        job->pidfd = -1;
+        driver->used_cores -= job->cores;
+
+        logger->info("Process {} finished with status {}: user time {:.2f}s, "
+                     "system time {:.2f}s, max rss {} kB",
+                     job->child_process, wait_status,
+                     local_driver_get_seconds(job->rusage.ru_utime),
+                     local_driver_get_seconds(job->rusage.ru_stime),
+                     job->rusage.ru_maxrss);
+
+        job_iter = driver->running_jobs.erase(job_iter);
+        if (job->freed)
+            delete job;
+    }
+}
+
+static void local_driver_reaper(local_driver_type *driver) {
+    std::vector<struct pollfd> poll_fds;
+    std::unique_lock lock(driver->lock);
+    while (!driver->stop) {
+        local_driver_start_jobs(driver);
+
+        int timeout = -1;
+        poll_fds.assign(1, {driver->wakeup_pipe[0], POLLIN, 0});
+        for (const auto *job : driver->running_jobs) {
+            if (job->pidfd >= 0)
+                poll_fds.push_back({job->pidfd, POLLIN, 0});
+            else
+                timeout = LOCAL_DRIVER_POLL_INTERVAL_MS;
+        }
+
+        lock.unlock();
+        poll(poll_fds.data(), poll_fds.size(), timeout);
+        char buffer[64];
+        while (read(driver->wakeup_pipe[0], buffer, sizeof buffer) > 0)
+            ;
+        lock.lock();
+
+        local_driver_reap_jobs(driver);
+    }
+}
+
 job_status_type local_driver_get_job_status(void *__driver, void *__job) {
     if (__job == NULL)
         /* The job has not been registered at all ... */
         return JOB_QUEUE_NOT_ACTIVE;
     else {
+        local_driver_type *driver =
+            reinterpret_cast<local_driver_type *>(__driver);
         local_job_type *job = reinterpret_cast<local_job_type *>(__job);
+        std::lock_guard guard{driver->lock};
         return job->status;
     }
 }
 
 void local_driver_free_job(void *__job) {
     local_job_type *job = reinterpret_cast<local_job_type *>(__job);
-    if (!job->active)
-        free(job);
+    local_driver_type *driver = job->driver;
+    if (driver == NULL) {
+        delete job;
+        return;
+    }
+
+    std::lock_guard guard{driver->lock};
+    auto &pending = driver->pending_jobs;
+    auto &running = driver->running_jobs;
+    pending.erase(std::remove(pending.begin(), pending.end(), job),
+                  pending.end());
+    if (std::find(running.begin(), running.end(), job) != running.end())
+        job->freed = true;
+    else
+        delete job;
 }
 
 void local_driver_kill_job(void *__driver, void *__job) {
+    local_driver_type *driver = reinterpret_cast<local_driver_type *>(__driver);
     local_job_type *job = reinterpret_cast<local_job_type *>(__job);
-    if (job->child_process > 0)
+    std::lock_guard guard{driver->lock};
+    if (job->status == JOB_QUEUE_PENDING) {
+        auto &pending = driver->pending_jobs;
+        pending.erase(std::remove(pending.begin(), pending.end(), job),
+                      pending.end());
+        job->status = JOB_QUEUE_IS_KILLED;
+    } else if (job->status == JOB_QUEUE_RUNNING)
         kill(job->child_process, SIGTERM);
 }
 
-/**
-  This function needs to dereference the job pointer after the waitpid() call is
-  complete, it is therefore essential that no other threads have called free(job)
-  while the external process is running.
-*/
-void submit_job_thread(const char *executable, int argc, char **argv,
-                       local_job_type *job) {
-    int wait_status;
-    job->child_process =
-        util_spawn(executable, argc, (const char **)argv, NULL, NULL);
-    util_free_stringlist(argv, argc);
-    waitpid(job->child_process, &wait_status, 0);
-
-    job->active = false;
-    job->status = JOB_QUEUE_EXIT;
-    if (WIFEXITED(wait_status))
-        if (WEXITSTATUS(wait_status) == 0)
-            job->status = JOB_QUEUE_DONE;
-}
-
 void *local_driver_submit_job(void *__driver, const char *submit_cmd,
-                              int num_cpu, /* Ignored */
-                              const char *run_path, const char *job_name,
-                              int argc, const char **argv) {
+                              int num_cpu, const char *run_path,
+                              const char *job_name, int argc,
+                              const char **argv) {
     local_driver_type *driver = reinterpret_cast<local_driver_type *>(__driver);
-    {
-        local_job_type *job = local_job_alloc();
+    local_job_type *job =
+        local_job_alloc(driver, submit_cmd, num_cpu, argc, argv);
 
-        auto argv_copy = util_alloc_stringlist_copy(argv, argc);
-
-        std::lock_guard guard{driver->submit_lock};
-        job->active = true;
-        job->status = JOB_QUEUE_RUNNING;
+    std::lock_guard guard{driver->lock};
+    driver->pending_jobs.push_back(job);
+    if (!driver->reaper)
+        driver->reaper = std::thread{[driver] { local_driver_reaper(driver); }};
+    else
+        local_driver_wakeup(driver);
+    return job;
+}
 
-        job->run_thread = std::thread{
-            [=] { submit_job_thread(submit_cmd, argc, argv_copy, job); }};
-        job->run_thread->detach();
+/**
+  Stops the reaper. Children which are still running are left running, and
+  are reaped by a detached thread when they exit, so they do not linger as
+  zombies. The jobs which have not been freed by the queue are detached from
+  the driver.
+*/
+void local_driver_free(local_driver_type *driver) {
+    {
+        std::lock_guard guard{driver->lock};
+        driver->stop = true;
+        local_driver_wakeup(driver);
+    }
+    if (driver->reaper)
+        driver->reaper->join();
 
-        return job;
+    std::vector<pid_t> children;
+    for (auto *job : driver->pending_jobs)
+        job->driver = NULL;
+    for (auto *job : driver->running_jobs) {
+        children.push_back(job->child_process);
+        if (job->pidfd >= 0)
+            close(job->pidfd);
+        if (job->freed)
+            delete job;
+        else
+            job->driver = NULL;
     }
-}
+    if (!children.empty())
+        std::thread{[children] {
+            for (pid_t pid : children)
+                while (waitpid(pid, NULL, 0) < 0 && errno == EINTR)
+                    ;
+        }}.detach();
 
-void local_driver_free(local_driver_type *driver) { delete driver; }
+    close(driver->wakeup_pipe[0]);
+    close(driver->wakeup_pipe[1]);
+    delete driver;
+}
 
 void local_driver_free__(void *__driver) {
     local_driver_type *driver = reinterpret_cast<local_driver_type *>(__driver);
     local_driver_free(driver);
 }
 
-void *local_driver_alloc() { return new local_driver_type; }
+void *local_driver_alloc() {
+    local_driver_type *driver = new local_driver_type;
+    driver->used_cores = 0;
+    driver->stop = false;
+    if (pipe2(driver->wakeup_pipe, O_CLOEXEC | O_NONBLOCK) != 0)
+        util_abort("%s: failed to create pipe: %s\n", __func__,
+                   strerror(errno));
+    local_driver_set_option(driver, LOCAL_MAX_CORES, NULL);
+    return driver;
+}
+
+bool local_driver_set_option(void *__driver, const char *option_key,
+                             const void *value_) {
+    local_driver_type *driver = reinterpret_cast<local_driver_type *>(__driver);
+    const char *value = (const char *)value_;
+    if (strcmp(LOCAL_MAX_CORES, option_key) != 0)
+        return false;
+
+    int max_cores = 0;
+    if (value != NULL && (!util_sscanf_int(value, &max_cores) || max_cores < 0))
+        return false;
+
+    std::lock_guard guard{driver->lock};
+    driver->max_cores = max_cores;
+    driver->max_cores_string = std::to_string(max_cores);
+    if (driver->reaper)
+        local_driver_wakeup(driver);
+    return true;
+}
+
+const void *local_driver_get_option(const void *__driver,
+                                    const char *option_key) {
+    const local_driver_type *driver =
+        reinterpret_cast<const local_driver_type *>(__driver);
+    if (strcmp(LOCAL_MAX_CORES, option_key) == 0)
+        return driver->max_cores_string.c_str();
+
+    util_abort("%s: option_id:%s not recognized for LOCAL driver \n", __func__,
+               option_key);
+    return NULL;
+}
 
 void local_driver_init_option_list(stringlist_type *option_list) {
-    //No options specific for local driver; do nothing
+    stringlist_append_copy(option_list, LOCAL_MAX_CORES);
 }
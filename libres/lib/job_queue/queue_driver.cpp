@@ -248,6 +248,8 @@ static UTIL_SAFE_CAST_FUNCTION(queue_driver, QUEUE_DRIVER_ID)
         driver->kill_job = local_driver_kill_job;
         driver->free_job = local_driver_free_job;
         driver->free_driver = local_driver_free__;
+        driver->set_option = local_driver_set_option;
+        driver->get_option = local_driver_get_option;
         driver->name = util_alloc_string_copy("local");
         driver->init_options = local_driver_init_option_list;
         driver->data = local_driver_alloc();
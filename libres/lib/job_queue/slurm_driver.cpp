@@ -23,6 +23,7 @@
 #include <string.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cmath>
 #include <ctime>
 #include <set>
@@ -84,7 +85,7 @@ public:
 
      3. The return value is a list of jobs which were previously registered as
         active, but are not fallen out. Calling scope must update their status
-        with calls to scontrol.
+        with a second squeue call which also lists finished jobs.
     */
     std::vector<int>
     squeue_update(const std::unordered_map<int, job_status_type> &squeue_jobs) {
@@ -156,39 +157,47 @@ struct slurm_driver_struct {
     std::string status_timeout_string;
 };
 
-static std::string load_file(const char *fname) {
-    char *buffer = util_fread_alloc_file_content(fname, nullptr);
-    std::string s = buffer;
-    free(buffer);
-    return s;
-}
-
-static std::string load_stdout(const char *cmd, int argc, const char **argv) {
+/**
+  Runs @cmd with @args and calls @parse with a stream of the stdout of the
+  command. The output goes through a temporary file, so @parse can read it
+  incrementally instead of getting it all in one string.
+*/
+template <typename F>
+static void parse_stdout(const char *cmd, const std::vector<std::string> &args,
+                         F parse) {
     std::string fname = std::string(cmd) + "-stdout";
-    char *stdout = (char *)util_alloc_tmp_file("/tmp", fname.c_str(), true);
-
-    auto exit_status = util_spawn_blocking(cmd, argc, argv, stdout, nullptr);
-    auto file_content = load_file(stdout);
+    char *stdout_file =
+        (char *)util_alloc_tmp_file("/tmp", fname.c_str(), true);
+    const char **argv =
+        static_cast<const char **>(util_calloc(args.size(), sizeof *argv));
+    for (std::size_t i = 0; i < args.size(); i++)
+        argv[i] = args[i].c_str();
 
+    auto exit_status = util_spawn_blocking(cmd, args.size(), argv, stdout_file,
+                                           nullptr);
+    free(argv);
     if (exit_status != 0)
         logger->warning(
             "Calling shell command %s ... returned non zero exitcode: %d", cmd,
             exit_status);
 
-    util_unlink_existing(stdout);
-    free(stdout);
-    return file_content;
+    FILE *stream = util_fopen(stdout_file, "r");
+    parse(stream);
+    fclose(stream);
+
+    util_unlink_existing(stdout_file);
+    free(stdout_file);
 }
 
 static std::string load_stdout(const char *cmd,
                                const std::vector<std::string> &args) {
-    const char **argv =
-        static_cast<const char **>(util_calloc(args.size(), sizeof *argv));
-    for (std::size_t i = 0; i < args.size(); i++)
-        argv[i] = args[i].c_str();
-
-    auto file_content = load_stdout(cmd, args.size(), argv);
-    free(argv);
+    std::string file_content;
+    parse_stdout(cmd, args, [&file_content](FILE *stream) {
+        char buffer[4096];
+        std::size_t count;
+        while ((count = fread(buffer, 1, sizeof buffer, stream)) > 0)
+            file_content.append(buffer, count);
+    });
     return file_content;
 }
 
@@ -483,69 +492,92 @@ slurm_driver_translate_status(const std::string &status_string,
     return JOB_QUEUE_UNKNOWN;
 }
 
-static std::unordered_map<std::string, std::string>
-load_scontrol(const slurm_driver_type *driver, const std::string &string_id) {
-    auto file_content =
-        load_stdout(driver->scontrol_cmd.c_str(), {"show", "jobid", string_id});
-
-    std::unordered_map<std::string, std::string> options;
-    std::size_t offset = 0;
-    while (true) {
-        auto new_offset = file_content.find_first_of("\n ", offset);
-        if (new_offset == std::string::npos)
-            break;
-
-        std::string key_value =
-            file_content.substr(offset, new_offset - offset);
-        auto split_pos = key_value.find('=');
-        if (split_pos != std::string::npos) {
-            std::string key = key_value.substr(0, split_pos);
-            std::string value = key_value.substr(split_pos + 1);
-
-            options.insert({key, value});
-        }
-        offset = file_content.find_first_not_of("\n ", new_offset);
+/**
+  Reads the '%i %T' formatted output of squeue from @stream, and sets the state
+  of the jobs which are already keys in @job_states. The output is read one
+  line at a time, and lines for other jobs are ignored.
+*/
+static void
+parse_squeue_job_states(FILE *stream,
+                        std::unordered_map<int, std::string> &job_states) {
+    const char *space = " \t\n";
+    char *line = nullptr;
+    std::size_t line_size = 0;
+    while (getline(&line, &line_size, stream) != -1) {
+        char *save_ptr;
+        char *id_token = strtok_r(line, space, &save_ptr);
+        char *state_token = strtok_r(nullptr, space, &save_ptr);
+        if (!id_token || !state_token)
+            continue;
+
+        char *id_end;
+        long job_id = strtol(id_token, &id_end, 10);
+        if (*id_end != '\0')
+            continue;
+
+        auto job_iter = job_states.find(job_id);
+        if (job_iter != job_states.end())
+            job_iter->second = state_token;
     }
-    return options;
+    free(line);
 }
 
-static job_status_type
-slurm_driver_get_job_status_scontrol(const slurm_driver_type *driver,
-                                     const std::string &string_id) {
-    auto values = load_scontrol(driver, string_id);
-    const auto status_iter = values.find("JobState");
-
-    // When a job has finished running it quite quickly - the order of minutes
-    // - falls out of the slurm database, and the scontrol command will not
-    // give any output. In this situation we guess that the job has completed
-    // succesfully and return status JOB_QUEUE_DONE. If the job has actually
-    // not succeded this should be picked up the libres post run checking.
-    if (status_iter == values.end()) {
-        logger->warning("The command 'scontrol show jobid {}' gave no "
-                        "output for job:{} - assuming it is COMPLETED",
-                        string_id, string_id);
-        return JOB_QUEUE_DONE;
+/**
+  Gets the status of the jobs @job_ids, which have fallen out of the regular
+  squeue listing, with one 'squeue -t all -j id1,id2,...' call. With '-t all'
+  squeue also reports jobs in a final state like COMPLETED or CANCELLED, as long
+  as the slurm controller still remembers them, and with '-j' only the
+  requested jobs are listed.
+*/
+static std::unordered_map<int, job_status_type>
+slurm_driver_get_job_status_finished(const slurm_driver_type *driver,
+                                     std::vector<int> job_ids) {
+    std::unordered_map<int, std::string> job_states;
+    std::vector<std::string> string_ids;
+    std::sort(job_ids.begin(), job_ids.end());
+    for (const auto &job_id : job_ids) {
+        job_states.emplace(job_id, "");
+        string_ids.push_back(std::to_string(job_id));
     }
 
-    const auto &status_string = status_iter->second;
-    auto status = slurm_driver_translate_status(status_string, string_id);
+    parse_stdout(driver->squeue_cmd.c_str(),
+                 {"-h", "-t", "all", "-j", join_string(string_ids), "-o",
+                  "%i %T"},
+                 [&job_states](FILE *stream) {
+                     parse_squeue_job_states(stream, job_states);
+                 });
+
+    std::unordered_map<int, job_status_type> status;
+    for (const auto &[job_id, status_string] : job_states) {
+        auto string_id = std::to_string(job_id);
+
+        // When a job has finished running it quite quickly - the order of
+        // minutes - falls out of the slurm controller, and the squeue command
+        // will not list it even with '-t all'. In this situation we guess that
+        // the job has completed succesfully and return status JOB_QUEUE_DONE.
+        // If the job has actually not succeded this should be picked up the
+        // libres post run checking.
+        if (status_string.empty()) {
+            logger->warning("The command 'squeue -t all' did not list "
+                            "job:{} - assuming it is COMPLETED",
+                            string_id);
+            status[job_id] = JOB_QUEUE_DONE;
+            continue;
+        }
 
-    if (status == JOB_QUEUE_UNKNOWN) {
-        logger->warning("The job status: '{}' for job:{} is not recognized "
-                        "- assuming it is RUNNING",
-                        status_string, string_id);
-        status = JOB_QUEUE_RUNNING;
+        auto job_status =
+            slurm_driver_translate_status(status_string, string_id);
+        if (job_status == JOB_QUEUE_UNKNOWN) {
+            logger->warning("The job status: '{}' for job:{} is not "
+                            "recognized - assuming it is RUNNING",
+                            status_string, string_id);
+            job_status = JOB_QUEUE_RUNNING;
+        }
+        status[job_id] = job_status;
     }
-
     return status;
 }
 
-static job_status_type
-slurm_driver_get_job_status_scontrol(const slurm_driver_type *driver,
-                                     int job_id) {
-    return slurm_driver_get_job_status_scontrol(driver, std::to_string(job_id));
-}
-
 static void slurm_driver_update_status_cache(const slurm_driver_type *driver) {
     driver->status_timestamp = time(nullptr);
     const std::string space = " \n";
@@ -571,25 +603,29 @@ static void slurm_driver_update_status_cache(const slurm_driver_type *driver) {
     }
 
     const auto &active_jobs = driver->status.squeue_update(squeue_jobs);
-    for (const auto &job_id : active_jobs) {
-        auto status = slurm_driver_get_job_status_scontrol(driver, job_id);
+    if (active_jobs.empty())
+        return;
+
+    for (const auto &[job_id, status] :
+         slurm_driver_get_job_status_finished(driver, active_jobs))
         driver->status.update(job_id, status);
-    }
 }
 
 /**
-  Getting the status of jobs involves two different executables - 'squeue' and
-  'scontrol'. While a job is pending in the queue and when it is actually
-  running the squeue command will give the status, but as soon as the job has
-  finished running the status is no longer reported by the squeue command. This
-  is in contrast to the 'bjobs' command used in LSF, which will report EXIT and
-  DONE status also after the job has finished running.
+  Getting the status of jobs involves two squeue calls. While a job is pending
+  in the queue and when it is actually running the regular squeue command will
+  give the status, but as soon as the job has finished running the status is no
+  longer reported by that command. This is in contrast to the 'bjobs' command
+  used in LSF, which will report EXIT and DONE status also after the job has
+  finished running.
 
   Because of fall out of the squeue status we must keep track of which jobs are
-  running, and then query with the scontrol command for the jobs which are not
-  reported by squeue. Unfortunately also the scontrol looses jobs after a couple
-  of minutes, when this happens we have hopefully recorded the eventual status
-  of the job.
+  running, and then query for the jobs which are not reported by squeue. All
+  the jobs which have fallen out of squeue in one update are resolved with a
+  single 'squeue -t all -j id1,id2,...' call, which only asks the slurm
+  controller about those jobs. Unfortunately also the controller looses jobs
+  after a couple of minutes, when this happens we have hopefully recorded the
+  eventual status of the job.
 */
 job_status_type slurm_driver_get_job_status(void *__driver, void *__job) {
     slurm_driver_type *driver = slurm_driver_safe_cast(__driver);
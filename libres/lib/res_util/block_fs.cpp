@@ -16,16 +16,26 @@
    for more details.
 */
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <filesystem>
+#include <fstream>
+#include <iterator>
 #include <mutex>
 #include <stdexcept>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include <errno.h>
+#include <fcntl.h>
 #include <fnmatch.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 #include <fmt/ostream.h>
@@ -41,6 +51,15 @@ namespace fs = std::filesystem;
 #define MOUNT_MAP_MAGIC_INT 8861290
 #define BLOCK_FS_TYPE_ID 7100652
 
+/*
+  The index file is written when a read-write instance is closed, and is used
+  to fill up the index at the next mount instead of scanning through the whole
+  data file. Index files written by older versions have a different layout,
+  they are rejected by the magic/version check and the data file is scanned.
+*/
+#define INDEX_MAGIC_INT 7355608
+#define INDEX_VERSION 1
+
 /*
   During mounting a significant part of the time is spent on filling
   up the index hash table. By default a hash table is created with a
@@ -66,7 +85,6 @@ namespace fs = std::filesystem;
 static const int NODE_END_TAG =
     16711935; /* Binary      =  00000000111111110000000011111111 */
 static const int NODE_WRITE_ACTIVE_START = WRITE_START__;
-static const int NODE_WRITE_ACTIVE_END = 776512;
 
 typedef enum {
     /** NODE_IN_USE_BYTE * ( 1 + 256 + 256**2 + 256**3) => Binary 01010101010101010101010101010101 */
@@ -97,14 +115,34 @@ struct file_node_struct {
 struct block_fs_struct {
     UTIL_TYPE_ID_DECLARATION;
 
+    /** All node reads and writes after the mount go through data_fd with
+     * pread()/pwrite(); the stdio data_stream is only used to scan the data
+     * file while mounting. */
     int data_fd;
     FILE *data_stream;
 
+    /** The data file is mapped into memory and the nodes are read directly
+     * from the mapping. NULL if the data file is not mapped. The mapping of
+     * a read-write instance can extend past the end of the file, only the
+     * first data_map_file_size bytes - the size of the file when it was
+     * mapped - are known to be backed by the file. */
+    const char *data_map;
+    size_t data_map_size;
+    size_t data_map_file_size;
+    /** Set when mmap() has failed; the instance then uses pread(). */
+    bool data_map_failed;
+    /** Mappings which have been replaced because the data file grew or was
+     * compacted. They are kept until block_fs_close(), so the views returned
+     * by block_fs_fread_view() stay valid. */
+    std::vector<std::pair<const char *, size_t>> retired_maps;
+
     /** The total number of bytes in the data_file. */
     long int data_file_size;
     /** The size of blocks in bytes. */
     int block_size;
 
+    /** Protects the index, the file_nodes vector and data_file_size; it is
+     * not held while the node content is read or written. */
     std::mutex mutex;
 
     /** THE HASH table of all the nodes/files which have been stored. */
@@ -117,10 +155,21 @@ struct block_fs_struct {
     bool data_owner;
     /** 0: never  n: every nth iteration. */
     int fsync_interval;
+    /** The number of fsync() calls on the data file since it was mounted. */
+    std::atomic<int> fsync_count{0};
+    /** The data file, which is replaced by block_fs_compact(). */
+    fs::path data_file;
+    /** The index file which is written by block_fs_close(). */
+    fs::path index_file;
 };
 
 UTIL_SAFE_CAST_FUNCTION(block_fs, BLOCK_FS_TYPE_ID)
 
+static void block_fs_fsync_data(block_fs_type *block_fs) {
+    block_fs->fsync_count++;
+    fsync(block_fs->data_fd);
+}
+
 static inline void fseek__(FILE *stream, long int arg, int whence) {
     if (fseek(stream, arg, whence) != 0) {
         fprintf(stderr, "** Warning - seek:%ld failed %s(%d) \n", arg,
@@ -246,27 +295,6 @@ static void file_node_fwrite(const file_node_type *file_node, const char *key,
     }
 }
 
-/**
-   This marks the start and end of the node with the integer tags:
-   NODE_WRITE_ACTIVE_START and NODE_WRITE_ACTIVE_END, signalling this
-   section in the data file is 'work in progress', and should be
-   discarded if the application aborts during the write.
-
-   When the write is complete file_node_fwrite() should be called,
-   which will replace the NODE_WRITE_ACTIVE_START and
-   NODE_WRITE_ACTIVE_END tags with NODE_IN_USE and NODE_END_TAG
-   identifiers.
-*/
-static void file_node_init_fwrite(const file_node_type *file_node,
-                                  FILE *stream) {
-    fseek__(stream, file_node->node_offset, SEEK_SET);
-    util_fwrite_int(NODE_WRITE_ACTIVE_START, stream);
-    fseek__(stream,
-            file_node->node_offset + file_node->node_size - sizeof NODE_END_TAG,
-            SEEK_SET);
-    util_fwrite_int(NODE_WRITE_ACTIVE_END, stream);
-}
-
 /**
    Observe that header in this context include the size of the tail
    marker NODE_END_TAG.
@@ -337,6 +365,10 @@ static block_fs_type *block_fs_alloc_empty(const fs::path &mount_file,
     block_fs_reinit(block_fs);
 
     block_fs->data_owner = !read_only;
+    block_fs->data_map = nullptr;
+    block_fs->data_map_size = 0;
+    block_fs->data_map_file_size = 0;
+    block_fs->data_map_failed = false;
     return block_fs;
 }
 
@@ -358,11 +390,6 @@ static void block_fs_fseek_node_end(block_fs_type *block_fs,
     block_fs_fseek(block_fs, file_node->node_offset + file_node->node_size);
 }
 
-static void block_fs_fseek_node_data(block_fs_type *block_fs,
-                                     const file_node_type *file_node) {
-    block_fs_fseek(block_fs, file_node->node_offset + file_node->data_offset);
-}
-
 /**
    This function will read through the datafile seeking for the identifier:
    NODE_IN_USE. If the valid status identifiers is found the stream is
@@ -454,7 +481,7 @@ static void block_fs_open_data(block_fs_type *block_fs,
 static void block_fs_fix_nodes(block_fs_type *block_fs,
                                const std::vector<long> &offset_list) {
     if (block_fs->data_owner) {
-        fsync(block_fs->data_fd);
+        block_fs_fsync_data(block_fs);
         {
             char *key = NULL;
             for (const auto &node_offset : offset_list) {
@@ -483,7 +510,7 @@ static void block_fs_fix_nodes(block_fs_type *block_fs,
             }
             free(key);
         }
-        fsync(block_fs->data_fd);
+        block_fs_fsync(block_fs);
     }
 }
 
@@ -548,6 +575,236 @@ static void block_fs_build_index(block_fs_type *block_fs,
     free(filename);
 }
 
+/**
+   Moves the current mapping to the retired mappings; the next call to
+   block_fs_map_data() will map the data file from scratch.
+*/
+static void block_fs_retire_map(block_fs_type *block_fs) {
+    if (block_fs->data_map != nullptr)
+        block_fs->retired_maps.emplace_back(block_fs->data_map,
+                                            block_fs->data_map_size);
+    block_fs->data_map = nullptr;
+    block_fs->data_map_size = 0;
+    block_fs->data_map_file_size = 0;
+}
+
+/**
+   Map the data file into memory, or remap it if it has grown past the
+   current mapping. Nodes are only appended to the data file, and the data
+   which is referenced by the index is never changed, so readers can copy
+   directly from the mapping.
+
+   A read-only instance maps the file once at mount, and its index is not
+   modified after that, so readers need no locking at all. A read-write
+   instance maps lazily, with the mutex held, and reserves twice the
+   previous size so the file is not remapped for every node appended to it.
+   The previous mapping is retired rather than unmapped, as other threads
+   may still hold views into it.
+
+   If the mapping fails the instance silently falls back to the pread()
+   based read path.
+*/
+static void block_fs_map_data(block_fs_type *block_fs) {
+    struct stat stat_buffer;
+    if (block_fs->data_fd < 0 || block_fs->data_map_failed)
+        return;
+
+    if (fstat(block_fs->data_fd, &stat_buffer) != 0 ||
+        stat_buffer.st_size == 0)
+        return;
+
+    const size_t file_size = stat_buffer.st_size;
+    if (file_size <= block_fs->data_map_size) {
+        block_fs->data_map_file_size = file_size;
+        return;
+    }
+
+    size_t map_size = file_size;
+    if (block_fs->data_owner)
+        map_size = std::max(file_size, 2 * block_fs->data_map_size);
+
+    void *map = mmap(nullptr, map_size, PROT_READ, MAP_SHARED,
+                     block_fs->data_fd, 0);
+    if (map == MAP_FAILED) {
+        fprintf(stderr, "** Warning: mmap() of block_fs data file failed: %s\n",
+                strerror(errno));
+        block_fs->data_map_failed = true;
+        return;
+    }
+
+    block_fs_retire_map(block_fs);
+    block_fs->data_map = (const char *)map;
+    block_fs->data_map_size = map_size;
+    block_fs->data_map_file_size = file_size;
+}
+
+static void block_fs_unmap_data(block_fs_type *block_fs) {
+    block_fs_retire_map(block_fs);
+    for (const auto &[map, map_size] : block_fs->retired_maps)
+        munmap((void *)map, map_size);
+    block_fs->retired_maps.clear();
+}
+
+static uint64_t block_fs_index_checksum(const char *data, size_t size) {
+    /* 64 bit FNV-1a */
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= (unsigned char)data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static long block_fs_data_disk_size(const block_fs_type *block_fs) {
+    struct stat stat_buffer;
+    if (block_fs->data_fd < 0 || fstat(block_fs->data_fd, &stat_buffer) != 0)
+        return -1;
+    return stat_buffer.st_size;
+}
+
+template <typename T> static void index_append(std::string &out, T value) {
+    out.append(reinterpret_cast<const char *>(&value), sizeof value);
+}
+
+/*
+   Index file layout:
+
+   |<magic: Int><version: Int><data_file_size: Long><disk_size: Long><num_nodes: Int>|
+   |<key_length: Int><key: Char[key_length]><node_offset: Long><node_size: Int><data_size: Int><data_offset: Int>|
+   |... one record per node ...|
+   |<checksum: UInt64>|
+
+   The checksum is calculated over everything in front of it. The disk_size
+   is the size of the data file when the index was written; the data file
+   is only ever appended to, so a different size on disk means that the
+   index is stale.
+*/
+static void block_fs_fwrite_index(block_fs_type *block_fs) {
+    std::string content;
+    index_append<int>(content, INDEX_MAGIC_INT);
+    index_append<int>(content, INDEX_VERSION);
+    index_append<long>(content, block_fs->data_file_size);
+    index_append<long>(content, block_fs_data_disk_size(block_fs));
+    index_append<int>(content, hash_get_size(block_fs->index));
+    {
+        hash_iter_type *iter = hash_iter_alloc(block_fs->index);
+        const char *key = hash_iter_get_next_key(iter);
+        while (key != NULL) {
+            const file_node_type *node =
+                (const file_node_type *)hash_get(block_fs->index, key);
+            index_append<int>(content, strlen(key));
+            content.append(key);
+            index_append<long>(content, node->node_offset);
+            index_append<int>(content, node->node_size);
+            index_append<int>(content, node->data_size);
+            index_append<int>(content, node->data_offset);
+            key = hash_iter_get_next_key(iter);
+        }
+        hash_iter_free(iter);
+    }
+    index_append<uint64_t>(
+        content, block_fs_index_checksum(content.data(), content.size()));
+
+    // Write to a temporary file and rename, so that an index file which
+    // exists is always complete.
+    auto tmp_file = block_fs->index_file;
+    tmp_file += ".tmp";
+    {
+        std::ofstream stream{tmp_file, std::ios::binary | std::ios::trunc};
+        stream.write(content.data(), content.size());
+        if (!stream)
+            return;
+    }
+    std::error_code ec;
+    fs::rename(tmp_file, block_fs->index_file, ec);
+    if (ec)
+        fs::remove(tmp_file, ec);
+}
+
+/**
+   Fill up the index from the index file. Returns false if the index file
+   does not exist, is corrupt or does not match the data file; the instance
+   is then left empty and the index must be built by scanning the data file.
+*/
+static bool block_fs_fread_index(block_fs_type *block_fs) {
+    std::string content;
+    {
+        std::ifstream stream{block_fs->index_file, std::ios::binary};
+        if (!stream)
+            return false;
+        content.assign(std::istreambuf_iterator<char>(stream),
+                       std::istreambuf_iterator<char>());
+    }
+
+    if (content.size() < sizeof(uint64_t))
+        return false;
+    {
+        const size_t payload_size = content.size() - sizeof(uint64_t);
+        uint64_t checksum;
+        memcpy(&checksum, content.data() + payload_size, sizeof checksum);
+        if (checksum !=
+            block_fs_index_checksum(content.data(), payload_size))
+            return false;
+        content.resize(payload_size);
+    }
+
+    size_t pos = 0;
+    auto read = [&](auto &value) {
+        if (pos + sizeof value > content.size())
+            return false;
+        memcpy(&value, content.data() + pos, sizeof value);
+        pos += sizeof value;
+        return true;
+    };
+
+    int magic, version, num_nodes;
+    long data_file_size, disk_size;
+    if (!(read(magic) && read(version) && read(data_file_size) &&
+          read(disk_size) && read(num_nodes)))
+        return false;
+    if (magic != INDEX_MAGIC_INT || version != INDEX_VERSION)
+        return false;
+    if (disk_size != block_fs_data_disk_size(block_fs) ||
+        data_file_size > disk_size)
+        return false;
+
+    hash_resize(block_fs->index, num_nodes + DEFAULT_INDEX_SIZE);
+    for (int i = 0; i < num_nodes; i++) {
+        int key_length, node_size, data_size, data_offset;
+        long node_offset;
+        if (!read(key_length) || key_length < 0 ||
+            pos + key_length > content.size())
+            break;
+        std::string key = content.substr(pos, key_length);
+        pos += key_length;
+
+        if (!(read(node_offset) && read(node_size) && read(data_size) &&
+              read(data_offset)))
+            break;
+        if (node_offset < 0 || node_size <= 0 ||
+            node_offset + node_size > data_file_size ||
+            data_offset + data_size > node_size)
+            break;
+
+        file_node_type *file_node =
+            file_node_alloc(NODE_IN_USE, node_offset, node_size);
+        file_node->data_size = data_size;
+        file_node->data_offset = data_offset;
+        block_fs_install_node(block_fs, file_node);
+        block_fs_insert_index_node(block_fs, key.c_str(), file_node);
+    }
+
+    if (hash_get_size(block_fs->index) != num_nodes || pos != content.size()) {
+        hash_free(block_fs->index);
+        vector_free(block_fs->file_nodes);
+        block_fs_reinit(block_fs);
+        return false;
+    }
+
+    block_fs->data_file_size = data_file_size;
+    return true;
+}
+
 bool block_fs_is_readonly(const block_fs_type *bfs) {
     if (bfs->data_owner)
         return false;
@@ -572,34 +829,45 @@ block_fs_type *block_fs_mount(const fs::path &mount_file, int block_size,
             block_fs = block_fs_alloc_empty(mount_file, block_size,
                                             fsync_interval, read_only);
 
+            block_fs->data_file = data_file;
+            block_fs->index_file = index_file;
             block_fs_open_data(block_fs, data_file);
             if (block_fs->data_stream != nullptr) {
-                std::error_code ec;
-                fs::remove(index_file, ec /* error code is ignored */);
-                block_fs_build_index(block_fs, data_file, fix_nodes);
+                if (!block_fs_fread_index(block_fs))
+                    block_fs_build_index(block_fs, data_file, fix_nodes);
+
+                // A read-write instance will append to the data file, so the
+                // index file is removed until it is written again at close.
+                if (block_fs->data_owner) {
+                    std::error_code ec;
+                    fs::remove(index_file, ec /* error code is ignored */);
+                }
             }
             block_fs_fix_nodes(block_fs, fix_nodes);
+            block_fs_map_data(block_fs);
         }
     }
     return block_fs;
 }
 
+/** Rounds min_size up to a whole number of blocks. */
+static int block_fs_node_size(const block_fs_type *block_fs, size_t min_size) {
+    div_t d = div(min_size, block_fs->block_size);
+    int node_size = d.quot * block_fs->block_size;
+    if (d.rem)
+        node_size += block_fs->block_size;
+    return node_size;
+}
+
 static file_node_type *block_fs_get_new_node(block_fs_type *block_fs,
                                              const char *filename,
                                              size_t min_size) {
 
     long int offset;
-    int node_size;
+    int node_size = block_fs_node_size(block_fs, min_size);
     file_node_type *new_node;
 
-    {
-        div_t d = div(min_size, block_fs->block_size);
-        node_size = d.quot * block_fs->block_size;
-        if (d.rem)
-            node_size += block_fs->block_size;
-    }
-
-    /* Must lock the total size here ... */
+    /* The caller must hold the mutex, this reserves the region in the file. */
     offset = block_fs->data_file_size;
     new_node = file_node_alloc(NODE_IN_USE, offset, node_size);
     block_fs_install_node(
@@ -618,80 +886,224 @@ bool block_fs_has_file(block_fs_type *block_fs, const char *filename) {
 }
 
 /**
-   It seems it is not enough to call fsync(); must also issue this
-   funny fseek + ftell combination to ensure that all data is on
-   disk after an uncontrolled shutdown.
+   The nodes are written with pwrite() directly to the file descriptor, the
+   fflush() is for the node headers which are rewritten through the stdio
+   stream by block_fs_fix_nodes() during the mount.
 
    Could possibly use fdatasync() to improve speed slightly?
 */
 void block_fs_fsync(block_fs_type *block_fs) {
-    if (block_fs->data_owner) {
-        //fdatasync( block_fs->data_fd );
-        fsync(block_fs->data_fd);
-        block_fs_fseek(block_fs, block_fs->data_file_size);
-        ftell(block_fs->data_stream);
+    if (block_fs->data_owner && block_fs->data_stream != NULL) {
+        fflush(block_fs->data_stream);
+        block_fs_fsync_data(block_fs);
     }
 }
 
 /**
-   The single lowest-level write function:
+   Set how often block_fs_fwrite_file() issues fsync(); 0 means never. This
+   is used to suspend the periodic fsync() calls while a large batch of
+   nodes is written, the caller is then responsible for calling
+   block_fs_fsync() when the batch is complete.
+*/
+void block_fs_set_fsync_interval(block_fs_type *block_fs, int fsync_interval) {
+    std::lock_guard guard{block_fs->mutex};
+    block_fs->fsync_interval = fsync_interval;
+}
 
-   3. seek to correct position.
-   4. Write the data with util_fwrite()
+/**
+   Returns the number of fsync() calls on the data file since the instance
+   was mounted.
+*/
+int block_fs_get_fsync_count(const block_fs_type *block_fs) {
+    return block_fs->fsync_count;
+}
 
-   7. increase the write_count
-   8. set the data_size field of the node.
+static void block_fs_pwrite_fd(int fd, const void *ptr, size_t size,
+                               long int offset) {
+    const char *data = (const char *)ptr;
+    while (size > 0) {
+        ssize_t bytes = pwrite(fd, data, size, offset);
+        if (bytes < 0) {
+            if (errno == EINTR)
+                continue;
+            util_abort("%s: writing %zu bytes at offset:%ld failed: %s \n",
+                       __func__, size, offset, strerror(errno));
+        }
+        data += bytes;
+        size -= bytes;
+        offset += bytes;
+    }
+}
+
+static void block_fs_pwrite(const block_fs_type *block_fs, const void *ptr,
+                            size_t size, long int offset) {
+    block_fs_pwrite_fd(block_fs->data_fd, ptr, size, offset);
+}
+
+static void block_fs_pread(const block_fs_type *block_fs, void *ptr,
+                           size_t size, long int offset) {
+    char *data = (char *)ptr;
+    while (size > 0) {
+        ssize_t bytes = pread(block_fs->data_fd, data, size, offset);
+        if (bytes < 0) {
+            if (errno == EINTR)
+                continue;
+            util_abort("%s: reading %zu bytes at offset:%ld failed: %s \n",
+                       __func__, size, offset, strerror(errno));
+        }
+        if (bytes == 0)
+            util_abort("%s: unexpected end of data file at offset:%ld \n",
+                       __func__, offset);
+        data += bytes;
+        size -= bytes;
+        offset += bytes;
+    }
+}
+
+/**
+   Assembles the header and the data of the node in memory, with the same
+   layout as file_node_fwrite() + util_fwrite_string(). The image must have
+   room for node->data_offset + node->data_size bytes; the NODE_END_TAG is not
+   included.
+*/
+static void file_node_fill_image(const file_node_type *node,
+                                 const char *filename, const void *ptr,
+                                 int status, char *image) {
+    const int key_length = strlen(filename);
+    auto put_int = [&image](int value) {
+        memcpy(image, &value, sizeof value);
+        image += sizeof value;
+    };
+    put_int(status);
+    put_int(key_length);
+    memcpy(image, filename, key_length + 1);
+    image += key_length + 1;
+    put_int(node->node_size);
+    put_int(node->data_size);
+    memcpy(image, ptr, node->data_size);
+}
+
+/**
+   The single lowest-level write function. The node must already have been
+   reserved with block_fs_get_new_node(), the region of the data file it
+   covers belongs to this writer alone, so the function is called without
+   holding the mutex.
+
+   The node header and the data are assembled in memory and written with one
+   pwrite(), with the status field set to NODE_WRITE_ACTIVE_START. When that
+   is complete the NODE_END_TAG is written, and finally the status is set to
+   NODE_IN_USE. If the application aborts before the last write the node is
+   discarded at the next mount.
 
    Observe that when 'designing' this file-system the priority has
    been on read-spead, one consequence of this is that all write
    operations are sandwiched between two fsync() calls; that
    guarantees that the read access (which should be the fast path) can
    be without any calls to fsync().
-
-   Not necessary to lock - since all writes are protected by the
-   'global' rwlock anyway.
 */
 static void block_fs_fwrite__(block_fs_type *block_fs, const char *filename,
-                              file_node_type *node, const void *ptr,
-                              int data_size) {
-    block_fs_fseek(block_fs, node->node_offset);
-    node->status = NODE_IN_USE;
-    node->data_size = data_size;
-    file_node_set_data_offset(node, filename);
-
-    // This marks the node section in the datafile as write in progress with:
-    // NODE_WRITE_ACTIVE_START ... NODE_WRITE_ACTIVE_END
-    file_node_init_fwrite(node, block_fs->data_stream);
-
-    /* Writes the actual data content. */
-    block_fs_fseek_node_data(block_fs, node);
-    util_fwrite(ptr, 1, data_size, block_fs->data_stream, __func__);
-
-    /* Writes the file node header data, including the NODE_END_TAG. */
-    file_node_fwrite(node, filename, block_fs->data_stream);
-
-    block_fs->write_count++;
-    if (block_fs->fsync_interval &&
-        ((block_fs->write_count % block_fs->fsync_interval) == 0))
-        block_fs_fsync(block_fs);
+                              const file_node_type *node, const void *ptr) {
+    std::vector<char> image(node->data_offset + node->data_size);
+    file_node_fill_image(node, filename, ptr, NODE_WRITE_ACTIVE_START,
+                         image.data());
+    block_fs_pwrite(block_fs, image.data(), image.size(), node->node_offset);
+    block_fs_pwrite(block_fs, &NODE_END_TAG, sizeof NODE_END_TAG,
+                    node->node_offset + node->node_size - sizeof NODE_END_TAG);
+
+    const int status = NODE_IN_USE;
+    block_fs_pwrite(block_fs, &status, sizeof status, node->node_offset);
 }
 
+/**
+   Only the reservation of the node and the update of the index are done
+   while holding the mutex, so several threads can write to the same
+   instance concurrently.
+*/
 void block_fs_fwrite_file(block_fs_type *block_fs, const char *filename,
                           const void *ptr, size_t data_size) {
     if (!block_fs->data_owner)
         throw std::runtime_error("tried to write to read only filesystem");
-    std::lock_guard guard{block_fs->mutex};
 
-    file_node_type *file_node;
-    bool new_node = true;
     size_t min_size = data_size + file_node_header_size(filename);
-
-    file_node = block_fs_get_new_node(block_fs, filename, min_size);
+    file_node_type *file_node;
+    {
+        std::lock_guard guard{block_fs->mutex};
+        file_node = block_fs_get_new_node(block_fs, filename, min_size);
+    }
+    file_node->data_size = data_size;
+    file_node_set_data_offset(file_node, filename);
 
     /* The actual writing ... */
-    block_fs_fwrite__(block_fs, filename, file_node, ptr, data_size);
-    if (new_node)
+    block_fs_fwrite__(block_fs, filename, file_node, ptr);
+
+    bool fsync_now;
+    {
+        std::lock_guard guard{block_fs->mutex};
         block_fs_insert_index_node(block_fs, filename, file_node);
+        block_fs->write_count++;
+        fsync_now = block_fs->fsync_interval &&
+                    ((block_fs->write_count % block_fs->fsync_interval) == 0);
+    }
+    if (fsync_now)
+        block_fs_fsync_data(block_fs);
+}
+
+/**
+   Writes all the nodes with one pwrite() call. The nodes are reserved as one
+   contiguous region of the data file, the complete region - headers, data
+   and end tags - is assembled in memory and written in one go. The nodes are
+   inserted in the index when the write is complete; a node whose end tag did
+   not make it to disk is discarded at the next mount.
+
+   If sync is true the data file is fsync()'ed once when the batch has been
+   written; the nodes in the batch do not count towards the periodic fsync()
+   calls of block_fs_fwrite_file().
+*/
+void block_fs_fwrite_batch(block_fs_type *block_fs,
+                           const std::vector<block_fs_batch_node> &nodes,
+                           bool sync) {
+    if (!block_fs->data_owner)
+        throw std::runtime_error("tried to write to read only filesystem");
+    if (nodes.empty())
+        return;
+
+    std::vector<file_node_type *> file_nodes;
+    file_nodes.reserve(nodes.size());
+    {
+        std::lock_guard guard{block_fs->mutex};
+        for (const auto &node : nodes) {
+            const char *filename = node.filename.c_str();
+            size_t min_size =
+                node.data.size() + file_node_header_size(filename);
+            file_nodes.push_back(
+                block_fs_get_new_node(block_fs, filename, min_size));
+        }
+    }
+
+    const long int batch_offset = file_nodes.front()->node_offset;
+    const file_node_type *last_node = file_nodes.back();
+    std::vector<char> image(last_node->node_offset + last_node->node_size -
+                            batch_offset);
+    for (size_t i = 0; i < nodes.size(); i++) {
+        const char *filename = nodes[i].filename.c_str();
+        file_node_type *file_node = file_nodes[i];
+        char *node_image = image.data() + file_node->node_offset - batch_offset;
+
+        file_node->data_size = nodes[i].data.size();
+        file_node_set_data_offset(file_node, filename);
+        file_node_fill_image(file_node, filename, nodes[i].data.data(),
+                             NODE_IN_USE, node_image);
+        memcpy(node_image + file_node->node_size - sizeof NODE_END_TAG,
+               &NODE_END_TAG, sizeof NODE_END_TAG);
+    }
+    block_fs_pwrite(block_fs, image.data(), image.size(), batch_offset);
+    if (sync)
+        block_fs_fsync_data(block_fs);
+
+    std::lock_guard guard{block_fs->mutex};
+    for (size_t i = 0; i < nodes.size(); i++)
+        block_fs_insert_index_node(block_fs, nodes[i].filename.c_str(),
+                                   file_nodes[i]);
 }
 
 void block_fs_fwrite_buffer(block_fs_type *block_fs, const char *filename,
@@ -700,21 +1112,230 @@ void block_fs_fwrite_buffer(block_fs_type *block_fs, const char *filename,
                          buffer_get_size(buffer));
 }
 
+/**
+   Looks up 'filename' in the memory mapped data file. On success *data
+   points to the content of the file, which is valid until block_fs_close()
+   is called, and *size is the size of the content in bytes. Returns false if
+   the data file can not be mapped.
+
+   A read-only instance looks the node up without taking the mutex. A
+   read-write instance holds the mutex for the lookup, and remaps the data
+   file when the node has been appended after the file was mapped; the
+   content is copied by the caller without the mutex.
+*/
+bool block_fs_fread_view(block_fs_type *block_fs, const char *filename,
+                         const void **data, size_t *size) {
+    std::unique_lock lock{block_fs->mutex, std::defer_lock};
+    if (block_fs->data_owner)
+        lock.lock();
+    else if (block_fs->data_map == nullptr)
+        return false;
+
+    const file_node_type *node =
+        (const file_node_type *)hash_get(block_fs->index, filename);
+    const size_t node_end =
+        node->node_offset + node->data_offset + node->data_size;
+    if (block_fs->data_owner && node_end > block_fs->data_map_file_size)
+        block_fs_map_data(block_fs);
+
+    if (node_end > block_fs->data_map_file_size) {
+        if (block_fs->data_owner)
+            return false;
+        throw std::runtime_error(fmt::format(
+            "block_fs node {} extends beyond the end of the data file",
+            filename));
+    }
+
+    *data = block_fs->data_map + node->node_offset + node->data_offset;
+    *size = node->data_size;
+    return true;
+}
+
 /**
    Reads the full content of 'filename' into the buffer.
 */
 void block_fs_fread_realloc_buffer(block_fs_type *block_fs,
                                    const char *filename, buffer_type *buffer) {
-    std::lock_guard guard{block_fs->mutex};
-    file_node_type *node =
-        (file_node_type *)hash_get(block_fs->index, filename);
+    {
+        const void *data;
+        size_t size;
+        if (block_fs_fread_view(block_fs, filename, &data, &size)) {
+            buffer_clear(buffer);
+            buffer_fwrite(buffer, data, 1, size);
+            buffer_rewind(buffer);
+            return;
+        }
+    }
+
+    long int offset;
+    std::vector<char> data;
+    {
+        std::lock_guard guard{block_fs->mutex};
+        const file_node_type *node =
+            (const file_node_type *)hash_get(block_fs->index, filename);
+        offset = node->node_offset + node->data_offset;
+        data.resize(node->data_size);
+    }
+    block_fs_pread(block_fs, data.data(), data.size(), offset);
 
     buffer_clear(buffer); /* Setting: content_size = 0; pos = 0;  */
+    buffer_fwrite(buffer, data.data(), 1, data.size());
+    buffer_rewind(buffer); /* Setting: pos = 0; */
+}
 
-    block_fs_fseek_node_data(block_fs, node);
-    buffer_stream_fread(buffer, node->data_size, block_fs->data_stream);
+/**
+   Reads size bytes, starting offset bytes into the content of 'filename',
+   into ptr; i.e. a part of a file can be read without reading all of it.
+*/
+void block_fs_fread_range(block_fs_type *block_fs, const char *filename,
+                          size_t offset, size_t size, void *ptr) {
+    auto check_range = [&](size_t data_size) {
+        if (offset + size > data_size)
+            throw std::out_of_range(fmt::format(
+                "block_fs read of {} bytes at offset {} beyond the end of {}",
+                size, offset, filename));
+    };
+    {
+        const void *data;
+        size_t data_size;
+        if (block_fs_fread_view(block_fs, filename, &data, &data_size)) {
+            check_range(data_size);
+            memcpy(ptr, (const char *)data + offset, size);
+            return;
+        }
+    }
 
-    buffer_rewind(buffer); /* Setting: pos = 0; */
+    long int file_offset;
+    {
+        std::lock_guard guard{block_fs->mutex};
+        const file_node_type *node =
+            (const file_node_type *)hash_get(block_fs->index, filename);
+        check_range(node->data_size);
+        file_offset = node->node_offset + node->data_offset + offset;
+    }
+    block_fs_pread(block_fs, ptr, size, file_offset);
+}
+
+/**
+   fsync() a directory, so that a file which has been renamed into it is
+   durable.
+*/
+static void block_fs_fsync_dir(const fs::path &path) {
+    int fd = open(path.empty() ? "." : path.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd < 0)
+        return;
+    fsync(fd);
+    close(fd);
+}
+
+/**
+   Rewrites the data file with only the nodes which are in the index, i.e.
+   the space of the nodes which have been overwritten is reclaimed. The live
+   nodes are written sorted on key, so all the realizations of a node are
+   stored next to each other. The new data file is written to a temporary
+   file which atomically replaces the old data file with rename(); if the
+   application is aborted before that, or the rename() fails, the old data
+   file and index are untouched.
+
+   Returns the number of bytes reclaimed, 0 if the data file could not be
+   replaced. This must not be called while other threads are reading from or
+   writing to the instance.
+*/
+long block_fs_compact(block_fs_type *block_fs) {
+    if (!block_fs->data_owner)
+        throw std::runtime_error("tried to compact read only filesystem");
+
+    std::lock_guard guard{block_fs->mutex};
+    std::vector<std::string> keys;
+    {
+        hash_iter_type *iter = hash_iter_alloc(block_fs->index);
+        const char *key = hash_iter_get_next_key(iter);
+        while (key != NULL) {
+            keys.emplace_back(key);
+            key = hash_iter_get_next_key(iter);
+        }
+        hash_iter_free(iter);
+    }
+    std::sort(keys.begin(), keys.end());
+
+    auto tmp_file = block_fs->data_file;
+    tmp_file += ".compact";
+    FILE *stream = util_fopen(tmp_file.c_str(), "w+");
+    const int fd = fileno(stream);
+
+    hash_type *index = hash_alloc();
+    vector_type *file_nodes = vector_alloc_new();
+    hash_resize(index, keys.size() + DEFAULT_INDEX_SIZE);
+
+    /* The nodes are assembled in a buffer which is written in large chunks. */
+    const size_t chunk_size = 1 << 22;
+    std::vector<char> chunk;
+    std::vector<char> data;
+    long int chunk_offset = 0;
+    long int offset = 0;
+    for (const auto &key : keys) {
+        const file_node_type *old_node =
+            (const file_node_type *)hash_get(block_fs->index, key.c_str());
+        data.resize(old_node->data_size);
+        block_fs_pread(block_fs, data.data(), data.size(),
+                       old_node->node_offset + old_node->data_offset);
+
+        int node_size = block_fs_node_size(
+            block_fs, data.size() + file_node_header_size(key.c_str()));
+        file_node_type *node = file_node_alloc(NODE_IN_USE, offset, node_size);
+        node->data_size = data.size();
+        file_node_set_data_offset(node, key.c_str());
+
+        chunk.resize(offset + node_size - chunk_offset);
+        char *image = chunk.data() + offset - chunk_offset;
+        file_node_fill_image(node, key.c_str(), data.data(), NODE_IN_USE,
+                             image);
+        memcpy(image + node_size - sizeof NODE_END_TAG, &NODE_END_TAG,
+               sizeof NODE_END_TAG);
+
+        vector_append_owned_ref(file_nodes, node, file_node_free__);
+        hash_insert_ref(index, key.c_str(), node);
+        offset += node_size;
+
+        if (chunk.size() >= chunk_size) {
+            block_fs_pwrite_fd(fd, chunk.data(), chunk.size(), chunk_offset);
+            chunk_offset = offset;
+            chunk.clear();
+        }
+    }
+    block_fs_pwrite_fd(fd, chunk.data(), chunk.size(), chunk_offset);
+    fsync(fd);
+
+    std::error_code ec;
+    fs::rename(tmp_file, block_fs->data_file, ec);
+    if (ec) {
+        // The old data file and index are untouched, so the instance can
+        // carry on as if the compaction was never attempted.
+        fprintf(stderr,
+                "** Warning: compaction of block_fs data file %s failed: %s\n",
+                block_fs->data_file.c_str(), ec.message().c_str());
+        fclose(stream);
+        fs::remove(tmp_file, ec /* error code is ignored */);
+        hash_free(index);
+        vector_free(file_nodes);
+        return 0;
+    }
+    block_fs_fsync_dir(block_fs->data_file.parent_path());
+
+    fclose(block_fs->data_stream);
+    block_fs->data_stream = stream;
+    block_fs->data_fd = fd;
+    block_fs_retire_map(block_fs);
+    block_fs->data_map_failed = false;
+
+    hash_free(block_fs->index);
+    vector_free(block_fs->file_nodes);
+    block_fs->index = index;
+    block_fs->file_nodes = file_nodes;
+
+    long reclaimed = block_fs->data_file_size - offset;
+    block_fs->data_file_size = offset;
+    return reclaimed;
 }
 
 /**
@@ -726,6 +1347,9 @@ void block_fs_fread_realloc_buffer(block_fs_type *block_fs,
 */
 void block_fs_close(block_fs_type *block_fs) {
     block_fs_fsync(block_fs);
+    block_fs_unmap_data(block_fs);
+    if (block_fs->data_owner && block_fs->data_stream != NULL)
+        block_fs_fwrite_index(block_fs);
 
     if (block_fs->data_stream != NULL)
         fclose(block_fs->data_stream);
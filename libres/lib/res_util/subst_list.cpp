@@ -17,6 +17,7 @@
 */
 
 #include <filesystem>
+#include <string>
 
 #include <ctype.h>
 #include <stdlib.h>
@@ -31,6 +32,7 @@
 
 #include <ert/res_util/subst_func.hpp>
 #include <ert/res_util/subst_list.hpp>
+#include <ert/res_util/subst_template.hpp>
 
 namespace fs = std::filesystem;
 
@@ -627,6 +629,36 @@ bool subst_list_update_buffer(const subst_list_type *subst_list,
     return (match1 || match2);
 }
 
+/**
+   Appends the (key, value) pairs of @subst_list and its parents to
+   @strings, in the order they are applied by subst_list_update_buffer(),
+   and the names of the functions to @func_names. The value can be NULL, in
+   which case the key is not substituted.
+*/
+void subst_list_get_substitutions(
+    const subst_list_type *subst_list,
+    std::vector<std::pair<const char *, const char *>> &strings,
+    std::vector<const char *> &func_names) {
+    if (subst_list->parent != NULL)
+        subst_list_get_substitutions(subst_list->parent, strings, func_names);
+
+    for (int index = 0; index < vector_get_size(subst_list->string_data);
+         index++) {
+        const subst_list_string_type *node =
+            (const subst_list_string_type *)vector_iget_const(
+                subst_list->string_data, index);
+        strings.emplace_back(node->key, node->value);
+    }
+
+    for (int index = 0; index < vector_get_size(subst_list->func_data);
+         index++) {
+        const subst_list_func_type *subst_func =
+            (const subst_list_func_type *)vector_iget_const(
+                subst_list->func_data, index);
+        func_names.push_back(subst_func->name);
+    }
+}
+
 /**
    This function reads the content of a file, and writes a new file
    where all substitutions in subst_list have been performed. Observe
@@ -640,12 +672,8 @@ bool subst_list_update_buffer(const subst_list_type *subst_list,
 */
 bool subst_list_filter_file(const subst_list_type *subst_list,
                             const char *src_file, const char *target_file) {
-    bool match;
     char *backup_file = NULL;
-    buffer_type *buffer = buffer_fread_alloc(src_file);
-    // Ensure that the buffer is a \0 terminated string:
-    buffer_fseek(buffer, 0, SEEK_END);
-    buffer_fwrite_char(buffer, '\0');
+    auto file_template = ert::subst_template::load(src_file);
 
     if (util_same_file(src_file, target_file)) {
         char *backup_prefix = util_alloc_sprintf("%s-%s", src_file, __func__);
@@ -656,20 +684,19 @@ bool subst_list_filter_file(const subst_list_type *subst_list,
     /* Writing backup file */
     if (backup_file != NULL) {
         FILE *stream = util_fopen(backup_file, "w");
-        buffer_stream_fwrite_n(buffer, 0, -1,
-                               stream); /* -1: Do not write the trailing \0. */
+        util_fwrite(file_template->text().data(), 1,
+                    file_template->text().size(), stream, __func__);
         fclose(stream);
     }
 
     /* Doing the actual update */
-    match = subst_list_update_buffer(subst_list, buffer);
+    std::string result;
+    bool match = file_template->instantiate({subst_list}, result);
 
     /* Writing updated file */
     {
         auto stream = mkdir_fopen(fs::path(target_file), "w");
-
-        buffer_stream_fwrite_n(buffer, 0, -1,
-                               stream); /* -1: Do not write the trailing \0. */
+        util_fwrite(result.data(), 1, result.size(), stream, __func__);
         fclose(stream);
     }
 
@@ -678,7 +705,6 @@ bool subst_list_filter_file(const subst_list_type *subst_list,
         remove(backup_file);
         free(backup_file);
     }
-    buffer_free(buffer);
     return match;
 }
 
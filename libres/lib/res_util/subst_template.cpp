@@ -0,0 +1,268 @@
+#include <array>
+#include <cstdint>
+#include <future>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+
+#include <stdlib.h>
+
+#include <ert/util/util.hpp>
+
+#include <ert/res_util/subst_template.hpp>
+
+namespace ert {
+
+/**
+   The template text split on the occurrences of the patterns. Segment i is
+   the literal text [offset, offset + length) followed by the pattern
+   slot (-1 for the last segment).
+*/
+struct subst_template::plan {
+    struct segment {
+        size_t offset;
+        size_t length;
+        int slot;
+    };
+
+    std::vector<std::string> patterns;
+    std::vector<segment> segments;
+    /** Whether the pattern occurs in the text. */
+    std::vector<bool> used;
+    /** False if the occurrences overlap or a function name occurs. */
+    bool single_pass = true;
+};
+
+namespace {
+/**
+   Whether inserting @value in some text can give an occurrence of
+   @pattern which is not entirely outside of @value; that is when the
+   pattern is in the value, overlaps the start or the end of the value, or
+   contains the value with text on both sides.
+*/
+bool can_create_pattern(std::string_view value, std::string_view pattern) {
+    if (value.find(pattern) != std::string_view::npos)
+        return true;
+
+    size_t max_overlap = std::min(value.size(), pattern.size() - 1);
+    for (size_t length = 1; length <= max_overlap; length++) {
+        if (value.substr(value.size() - length) == pattern.substr(0, length))
+            return true;
+        if (value.substr(0, length) == pattern.substr(pattern.size() - length))
+            return true;
+    }
+
+    auto pos = pattern.find(value, 1);
+    return pos != std::string_view::npos &&
+           pos + value.size() < pattern.size();
+}
+
+/**
+   A template in the cache of subst_template::load(). The template is a
+   future which is ready when the thread which added the entry has read the
+   file.
+*/
+struct cached_template {
+    std::filesystem::file_time_type mtime;
+    std::uintmax_t size;
+    std::shared_future<std::shared_ptr<const subst_template>> file_template;
+};
+
+std::mutex template_cache_lock;
+std::unordered_map<std::string, cached_template> template_cache;
+
+bool update_string(const subst_list_type *subst_list, std::string &text) {
+    char *buffer = util_alloc_string_copy(text.c_str());
+    bool match = subst_list_update_string(subst_list, &buffer);
+    text = buffer;
+    free(buffer);
+    return match;
+}
+} // namespace
+
+subst_template::subst_template(std::string text) : m_text(std::move(text)) {}
+
+/**
+   Returns the template with the content of the file @path. The templates
+   are cached on the absolute path, and a template is only read again if
+   the modification time or the size of the file has changed.
+
+   The cache lock is only held while looking up the entry. A thread which
+   needs a template being read by another thread waits for the future of
+   that entry, so each file is read once while other files are read in
+   parallel.
+*/
+std::shared_ptr<const subst_template>
+subst_template::load(const std::filesystem::path &path) {
+    std::error_code ec;
+    std::uintmax_t size = 0;
+    std::string cache_key;
+    auto mtime = std::filesystem::last_write_time(path, ec);
+    if (!ec)
+        size = std::filesystem::file_size(path, ec);
+    if (!ec)
+        cache_key = std::filesystem::absolute(path, ec).string();
+
+    std::promise<std::shared_ptr<const subst_template>> promise;
+    if (!ec) {
+        std::shared_future<std::shared_ptr<const subst_template>> cached;
+        {
+            std::scoped_lock lock(template_cache_lock);
+            auto iter = template_cache.find(cache_key);
+            if (iter != template_cache.end() && iter->second.mtime == mtime &&
+                iter->second.size == size)
+                cached = iter->second.file_template;
+            else
+                template_cache[cache_key] = {mtime, size,
+                                             promise.get_future().share()};
+        }
+        if (cached.valid())
+            return cached.get();
+    }
+
+    // If the file can not be read util_fread_alloc_file_content() fails
+    // hard, as the uncached loading of templates did.
+    int content_size;
+    char *content = util_fread_alloc_file_content(path.c_str(), &content_size);
+    auto file_template = std::make_shared<const subst_template>(
+        std::string(content, content_size));
+    free(content);
+
+    promise.set_value(file_template);
+    return file_template;
+}
+
+/**
+   Empties the cache of subst_template::load(), e.g. when all the runpaths
+   of an ensemble have been created. Templates which are in use are kept
+   alive by their users.
+*/
+void subst_template::clear_cache() {
+    std::scoped_lock lock(template_cache_lock);
+    template_cache.clear();
+}
+
+/**
+   Returns the plan for @patterns, where the first @num_keys are keys and
+   the rest function names, compiling it unless the previous plan was for
+   the same patterns.
+*/
+std::shared_ptr<const subst_template::plan>
+subst_template::get_plan(const std::vector<std::string> &patterns,
+                         int num_keys) const {
+    std::scoped_lock lock(m_plan_lock);
+    if (m_plan && m_plan->patterns == patterns)
+        return m_plan;
+
+    auto new_plan = std::make_shared<plan>();
+    new_plan->patterns = patterns;
+    new_plan->used.resize(patterns.size(), false);
+
+    std::array<std::vector<int>, 256> candidates;
+    for (size_t index = 0; index < patterns.size(); index++) {
+        if (patterns[index].empty())
+            new_plan->single_pass = false;
+        else
+            candidates[(unsigned char)patterns[index][0]].push_back(index);
+    }
+
+    size_t literal_start = 0;
+    size_t occurrence_end = 0;
+    for (size_t pos = 0; pos < m_text.size() && new_plan->single_pass;
+         pos++) {
+        for (int index : candidates[(unsigned char)m_text[pos]]) {
+            const std::string &pattern = patterns[index];
+            if (m_text.compare(pos, pattern.size(), pattern) != 0)
+                continue;
+
+            if (pos < occurrence_end || index >= num_keys) {
+                new_plan->single_pass = false;
+                break;
+            }
+            new_plan->segments.push_back(
+                {literal_start, pos - literal_start, index});
+            new_plan->used[index] = true;
+            literal_start = pos + pattern.size();
+            occurrence_end = literal_start;
+        }
+    }
+    new_plan->segments.push_back(
+        {literal_start, m_text.size() - literal_start, -1});
+
+    m_plan = new_plan;
+    return m_plan;
+}
+
+/**
+   Writes the template text with the substitutions of @subst_lists to
+   @result. The subst_lists are applied in order, and NULL entries are
+   ignored. Returns true if anything was substituted, like
+   subst_list_update_buffer().
+*/
+bool subst_template::instantiate(
+    const std::vector<const subst_list_type *> &subst_lists,
+    std::string &result) const {
+    std::vector<std::pair<const char *, const char *>> strings;
+    std::vector<const char *> func_names;
+    for (const auto *subst_list : subst_lists) {
+        if (subst_list)
+            subst_list_get_substitutions(subst_list, strings, func_names);
+    }
+
+    // The first value of a key is the one which is substituted; later
+    // definitions of the same key will not find anything to replace.
+    std::vector<std::string> patterns;
+    std::vector<const char *> values;
+    std::unordered_map<std::string_view, int> key_index;
+    for (const auto &[key, value] : strings) {
+        auto [iter, inserted] = key_index.emplace(key, patterns.size());
+        if (inserted) {
+            patterns.push_back(key);
+            values.push_back(value);
+        } else if (values[iter->second] == NULL)
+            values[iter->second] = value;
+    }
+    const int num_keys = patterns.size();
+    patterns.insert(patterns.end(), func_names.begin(), func_names.end());
+
+    auto plan = get_plan(patterns, num_keys);
+    bool single_pass = plan->single_pass;
+    for (int index = 0; index < num_keys && single_pass; index++) {
+        if (!plan->used[index] || values[index] == NULL)
+            continue;
+        for (const auto &pattern : patterns) {
+            if (can_create_pattern(values[index], pattern)) {
+                single_pass = false;
+                break;
+            }
+        }
+    }
+
+    if (!single_pass) {
+        bool match = false;
+        result = m_text;
+        for (const auto *subst_list : subst_lists) {
+            if (subst_list)
+                match = update_string(subst_list, result) || match;
+        }
+        return match;
+    }
+
+    bool match = false;
+    result.clear();
+    result.reserve(m_text.size());
+    for (const auto &segment : plan->segments) {
+        result.append(m_text, segment.offset, segment.length);
+        if (segment.slot < 0)
+            continue;
+
+        if (values[segment.slot] != NULL) {
+            result.append(values[segment.slot]);
+            match = true;
+        } else
+            result.append(patterns[segment.slot]);
+    }
+    return match;
+}
+
+} // namespace ert
@@ -17,6 +17,8 @@
 */
 
 #include <filesystem>
+#include <memory>
+#include <string>
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -28,11 +30,24 @@
 #include <ert/util/util.hpp>
 
 #include <ert/res_util/subst_list.hpp>
+#include <ert/res_util/subst_template.hpp>
 #include <ert/res_util/template.hpp>
 #include <ert/res_util/template_type.hpp>
 
 namespace fs = std::filesystem;
 
+/** The name of the template file, with the substitutions performed. */
+static char *template_alloc_filename(const template_type *_template,
+                                     const subst_list_type *ext_arg_list) {
+    char *template_file = util_alloc_string_copy(_template->template_file);
+
+    subst_list_update_string(_template->arg_list, &template_file);
+    if (ext_arg_list != NULL)
+        subst_list_update_string(ext_arg_list, &template_file);
+
+    return template_file;
+}
+
 /**
    Iff the template is set up with internaliz_template == false the
    template content is loaded at instantiation time, and in that case
@@ -46,14 +61,8 @@ namespace fs = std::filesystem;
 static char *template_load(const template_type *_template,
                            const subst_list_type *ext_arg_list) {
     int buffer_size;
-    char *template_file = util_alloc_string_copy(_template->template_file);
-    char *template_buffer;
-
-    subst_list_update_string(_template->arg_list, &template_file);
-    if (ext_arg_list != NULL)
-        subst_list_update_string(ext_arg_list, &template_file);
-
-    template_buffer =
+    char *template_file = template_alloc_filename(_template, ext_arg_list);
+    char *template_buffer =
         util_fread_alloc_file_content(template_file, &buffer_size);
     free(template_file);
 
@@ -150,25 +159,31 @@ void template_instantiate(const template_type *template_,
         subst_list_update_string(arg_list, &target_file);
 
     {
-        char *char_buffer;
         /* Loading the template - possibly expanding keys in the filename */
+        std::shared_ptr<const ert::subst_template> content_template;
         if (template_->internalize_template)
-            char_buffer = util_alloc_string_copy(template_->template_buffer);
-        else
-            char_buffer = template_load(template_, arg_list);
+            content_template = std::make_shared<const ert::subst_template>(
+                template_->template_buffer);
+        else {
+            char *template_file = template_alloc_filename(template_, arg_list);
+            content_template = ert::subst_template::load(template_file);
+            free(template_file);
+        }
 
         /* Substitutions on the content. */
-        subst_list_update_string(template_->arg_list, &char_buffer);
-        if (arg_list != NULL)
-            subst_list_update_string(arg_list, &char_buffer);
+        std::string content;
+        content_template->instantiate({template_->arg_list, arg_list}, content);
 
 #ifdef ERT_HAVE_REGEXP
         {
-            buffer_type *buffer = buffer_alloc_private_wrapper(
-                char_buffer, strlen(char_buffer) + 1);
+            char *char_buffer = util_alloc_string_copy(content.c_str());
+            buffer_type *buffer =
+                buffer_alloc_private_wrapper(char_buffer, content.size() + 1);
             template_eval_loops(template_, buffer);
             char_buffer = (char *)buffer_get_data(buffer);
             buffer_free_container(buffer);
+            content = char_buffer;
+            free(char_buffer);
         }
 #endif
 
@@ -182,10 +197,9 @@ void template_instantiate(const template_type *template_,
         /* Write the content out. */
         {
             auto stream = mkdir_fopen(fs::path(target_file), "w");
-            fprintf(stream, "%s", char_buffer);
+            fprintf(stream, "%s", content.c_str());
             fclose(stream);
         }
-        free(char_buffer);
     }
 
     free(target_file);
@@ -156,7 +156,51 @@ void test_multiply() {
     rng_free(rng);
 }
 
+void test_multiply_direct() {
+    const int data_size = 5000;
+    const int ens_size = 50;
+    Eigen::MatrixXd A0 = Eigen::MatrixXd::Random(data_size, ens_size);
+    Eigen::MatrixXd X0 = Eigen::MatrixXd::Random(ens_size, ens_size);
+    rng_type *rng = rng_alloc(MZRAN, INIT_DEFAULT);
+
+    // The direct multiply should agree with the grouped multiply
+    {
+        RowScaling row_scaling;
+        for (int row = 0; row < data_size; row++)
+            row_scaling.assign(row, rng_get_double(rng));
+
+        Eigen::MatrixXd A1 = A0;
+        Eigen::MatrixXd A2 = A0;
+        row_scaling.multiply(A1, X0);
+        row_scaling.multiply_direct(A2, X0);
+        test_assert_true(A1.isApprox(A2, 1e-12));
+    }
+
+    // Without clamping the values are used as assigned
+    {
+        RowScaling row_scaling(false);
+        std::vector<double> row_data(data_size);
+        for (int row = 0; row < data_size; row++)
+            row_data[row] = rng_get_double(rng);
+        row_scaling.assign_vector(row_data.data(), row_data.size());
+
+        Eigen::MatrixXd A = A0;
+        Eigen::MatrixXd AX = A0 * X0;
+        row_scaling.multiply_direct(A, X0);
+        for (int row = 0; row < data_size; row++) {
+            double alpha = row_data[row];
+            test_assert_double_equal(row_scaling[row], alpha);
+            for (int col = 0; col < ens_size; col++)
+                test_assert_double_equal(A(row, col),
+                                         alpha * AX(row, col) +
+                                             (1 - alpha) * A0(row, col));
+        }
+    }
+    rng_free(rng);
+}
+
 int main(int argc, char **argv) {
     test_create();
     test_multiply();
+    test_multiply_direct();
 }
@@ -48,14 +48,21 @@
      a) We run the squeue command, that does not report on cancelled jobs and
         will not report status for job 1.
 
-     b) We run the scontrol command which through a detailed request finds the
-        cancelled status of the job.
+     b) We run the squeue command again with '-t all -j 1,4,5', which lists
+        the cancelled status of the job.
 
   2: / 3: These jobs are PENDING and RUNNING respoectively, that status is
      reported by the squeue command.
 
   4: This job has been completed. As with the canceled job 1 we need to go
-     through both squeue and scontrol before we get the status of the job.
+     through both squeue calls before we get the status of the job.
+
+  5: This job has fallen out of both squeue calls, and is assumed to have
+     completed.
+
+  The jobs which are not reported by the regular squeue call are all resolved
+  with one 'squeue -t all -j ...' call. The mock fails unless exactly the ids of
+  the vanished jobs are requested, and scontrol is never called.
 
 */
 
@@ -107,6 +114,10 @@ fi
 if [ $2 = "--job-name=4" ]; then
    echo 4
 fi
+
+if [ $2 = "--job-name=5" ]; then
+   echo 5
+fi
 )";
 
     std::string scancel = R"(#!/bin/bash
@@ -115,75 +126,23 @@ exit 0
 )";
 
     std::string scontrol = R"(#!/bin/bash
-if [ $3 = "1" ]; then
-cat <<EOF
-   UserId=user(777) GroupId=group(888) MCS_label=N/A
-   Priority=4294901494 Nice=0 Account=(null) QOS=(null)
-   JobState=CANCELLED Reason=None Dependency=(null)
-   Requeue=1 Restarts=0 BatchFlag=1 Reboot=0 ExitCode=0:0
-   RunTime=00:00:22 TimeLimit=UNLIMITED TimeMin=N/A
-   SubmitTime=2020-06-08T19:43:54 EligibleTime=2020-06-08T19:43:54
-   AccrueTime=Unknown
-   StartTime=2020-06-08T19:43:55 EndTime=Unknown Deadline=N/A
-   PreemptTime=None SuspendTime=None SecsPreSuspend=0
-   LastSchedEval=2020-06-08T19:43:55
-   Partition=debug AllocNode:Sid=ws:13314
-   ReqNodeList=(null) ExcNodeList=(null)
-   NodeList=ws
-   BatchHost=ws
-   NumNodes=1 NumCPUs=1 NumTasks=1 CPUs/Task=1 ReqB:S:C:T=0:0:*:*
-   TRES=cpu=1,node=1,billing=1
-   Socks/Node=* NtasksPerN:B:S:C=0:0:*:* CoreSpec=*
-   MinCPUsNode=1 MinMemoryNode=0 MinTmpDiskNode=0
-   Features=(null) DelayBoot=00:00:00
-   OverSubscribe=OK Contiguous=0 Licenses=(null) Network=(null)
-   Command=/tmp/flow.sh
-   WorkDir=/home/user/work/ERT/libres/build
-   StdErr=/home/user/work/ERT/libres/build/slurm-7625.out
-   StdIn=/dev/null
-   StdOut=/home/user/work/ERT/libres/build/slurm-7625.out
-   Power=
-
-EOF
-fi
+exit 1
+)";
 
-if [ $3 = "4" ]; then
-cat <<EOF
-   UserId=user(777) GroupId=group(888) MCS_label=N/A
-   Priority=4294901494 Nice=0 Account=(null) QOS=(null)
-   JobState=COMPLETED Reason=None Dependency=(null)
-   Requeue=1 Restarts=0 BatchFlag=1 Reboot=0 ExitCode=0:0
-   RunTime=00:00:22 TimeLimit=UNLIMITED TimeMin=N/A
-   SubmitTime=2020-06-08T19:43:54 EligibleTime=2020-06-08T19:43:54
-   AccrueTime=Unknown
-   StartTime=2020-06-08T19:43:55 EndTime=Unknown Deadline=N/A
-   PreemptTime=None SuspendTime=None SecsPreSuspend=0
-   LastSchedEval=2020-06-08T19:43:55
-   Partition=debug AllocNode:Sid=ws:13314
-   ReqNodeList=(null) ExcNodeList=(null)
-   NodeList=ws
-   BatchHost=ws
-   NumNodes=1 NumCPUs=1 NumTasks=1 CPUs/Task=1 ReqB:S:C:T=0:0:*:*
-   TRES=cpu=1,node=1,billing=1
-   Socks/Node=* NtasksPerN:B:S:C=0:0:*:* CoreSpec=*
-   MinCPUsNode=1 MinMemoryNode=0 MinTmpDiskNode=0
-   Features=(null) DelayBoot=00:00:00
-   OverSubscribe=OK Contiguous=0 Licenses=(null) Network=(null)
-   Command=/tmp/flow.sh
-   WorkDir=/home/user/work/ERT/libres/build
-   StdErr=/home/user/work/ERT/libres/build/slurm-7625.out
-   StdIn=/dev/null
-   StdOut=/home/user/work/ERT/libres/build/slurm-7625.out
-   Power=
-
-EOF
+    std::string squeue = R"(#!/bin/bash
+if [ "$1" = "-h" ] && [[ "$2" == --user=* ]]; then
+   echo "2 PENDING"
+   echo "3 RUNNING"
+   exit 0
 fi
 
-)";
+if [ "$*" != "-h -t all -j 1,4,5 -o %i %T" ]; then
+   exit 1
+fi
 
-    std::string squeue = R"(#!/bin/bash
-echo "2 PENDING"
-echo "3 RUNNING"
+echo "1 CANCELLED"
+echo "7625 FAILED"
+echo "4 COMPLETED"
 )";
 
     install_script(driver, SLURM_SBATCH_OPTION, sbatch);
@@ -235,6 +194,12 @@ void run() {
         jobs.push_back(job);
     }
 
+    {
+        auto job = submit_job(driver, ta, "5", cmd);
+        test_assert_not_NULL(job);
+        jobs.push_back(job);
+    }
+
     queue_driver_kill_job(driver, jobs[0]);
     auto job1_status = queue_driver_get_status(driver, jobs[0]);
     test_assert_int_equal(job1_status, JOB_QUEUE_IS_KILLED);
@@ -248,6 +213,9 @@ void run() {
     auto job4_status = queue_driver_get_status(driver, jobs[3]);
     test_assert_int_equal(job4_status, JOB_QUEUE_DONE);
 
+    auto job5_status = queue_driver_get_status(driver, jobs[4]);
+    test_assert_int_equal(job5_status, JOB_QUEUE_DONE);
+
     for (auto job : jobs)
         queue_driver_free_job(driver, job);
 
@@ -21,6 +21,7 @@
 #include <ert/util/util.hpp>
 
 #include <ert/job_queue/job_queue.hpp>
+#include <ert/job_queue/local_driver.hpp>
 #include <ert/job_queue/lsf_driver.hpp>
 
 #include <ert/job_queue/rsh_driver.hpp>
@@ -74,6 +75,16 @@ void set_option_invalid_value_returns_false() {
 }
 
 void set_option_valid_on_specific_driver_returns_true() {
+    queue_driver_type *driver_local = queue_driver_alloc(LOCAL_DRIVER);
+    test_assert_true(
+        queue_driver_set_option(driver_local, LOCAL_MAX_CORES, "8"));
+    test_assert_string_equal(
+        "8", (const char *)queue_driver_get_option(driver_local,
+                                                   LOCAL_MAX_CORES));
+    test_assert_false(
+        queue_driver_set_option(driver_local, LOCAL_MAX_CORES, "-1"));
+    queue_driver_free(driver_local);
+
     queue_driver_type *driver_torque = queue_driver_alloc(TORQUE_DRIVER);
     test_assert_true(
         queue_driver_set_option(driver_torque, TORQUE_NUM_CPUS_PER_NODE, "33"));
@@ -114,6 +125,7 @@ void get_driver_option_lists() {
         queue_driver_init_option_list(driver_local, option_list);
 
         test_assert_true(stringlist_contains(option_list, MAX_RUNNING));
+        test_assert_true(stringlist_contains(option_list, LOCAL_MAX_CORES));
 
         stringlist_free(option_list);
         queue_driver_free(driver_local);
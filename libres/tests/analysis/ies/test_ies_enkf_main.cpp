@@ -1,3 +1,4 @@
+#include <filesystem>
 #include <vector>
 
 #include <Eigen/Dense>
@@ -8,6 +9,8 @@
 #include <ert/analysis/ies/ies.hpp>
 #include <ert/analysis/ies/ies_data.hpp>
 
+#include "../../tmpdir.hpp"
+
 TEST_CASE("ies_enkf_linalg_extract_active_E", "[analysis]") {
     int obs_size = 3;
     int ens_size = 2;
@@ -164,3 +167,47 @@ SCENARIO("ies_enkf_linalg_extract_active_A", "[analysis]") {
         }
     }
 }
+
+SCENARIO("ies_data_multiply_activeA", "[analysis]") {
+    GIVEN("An initial ensemble spanning several row blocks") {
+        const int ens_size = 5;
+        const int state_size = 10000;
+        WITH_TMPDIR;
+        ies::Data data(ens_size);
+        std::vector<bool> ens_mask(ens_size, true);
+        std::vector<bool> obs_mask(1, true);
+        Eigen::MatrixXd A0 = Eigen::MatrixXd::Random(state_size, ens_size);
+        ies::init_update(data, ens_mask, obs_mask);
+
+        const bool on_disk = GENERATE(false, true);
+        if (on_disk)
+            data.set_A0_file("A0");
+        data.store_initialA(A0);
+        REQUIRE(data.has_A0_file() == on_disk);
+        REQUIRE(std::filesystem::exists("A0") == on_disk);
+        REQUIRE(data.getA0() == A0);
+
+        WHEN("One realization is deactivated") {
+            ens_mask[1] = false;
+            data.update_ens_mask(ens_mask);
+
+            Eigen::MatrixXd X = Eigen::MatrixXd::Random(ens_size - 1, 3);
+            Eigen::MatrixXd A(state_size, 3);
+            data.multiply_activeA(X, A);
+            THEN("The result equals the product with the active A0") {
+                Eigen::MatrixXd expected = data.make_activeA() * X;
+                REQUIRE(A.isApprox(expected));
+            }
+
+            THEN("Mismatched sizes are rejected") {
+                Eigen::MatrixXd A_wrong(state_size - 1, 3);
+                REQUIRE_THROWS_AS(data.multiply_activeA(X, A_wrong),
+                                  std::invalid_argument);
+            }
+        }
+
+        THEN("The A0 file can not be set after A0 is stored") {
+            REQUIRE_THROWS_AS(data.set_A0_file("A1"), std::logic_error);
+        }
+    }
+}
@@ -0,0 +1,81 @@
+#include <cmath>
+
+#include <Eigen/Dense>
+#include <catch2/catch.hpp>
+
+#include <ert/analysis/ies/ies.hpp>
+
+namespace ies {
+Eigen::MatrixXd linalg_solve_S(const Eigen::MatrixXd &W0,
+                               const Eigen::MatrixXd &Y);
+
+void linalg_exact_inversion(Eigen::MatrixXd &W0, const int ies_inversion,
+                            const Eigen::MatrixXd &S, const Eigen::MatrixXd &H,
+                            double ies_steplength);
+} // namespace ies
+
+namespace {
+/** The full pivot LU solution of Omega^T S^T = Y^T used before. */
+Eigen::MatrixXd reference_solve_S(const Eigen::MatrixXd &W0,
+                                  const Eigen::MatrixXd &Y) {
+    double nsc = 1.0 / sqrt(W0.cols() - 1.0);
+    Eigen::MatrixXd Omega = nsc * (W0.colwise() - W0.rowwise().mean());
+    Omega.transposeInPlace();
+    Omega.diagonal().array() += 1.0;
+    return Omega.fullPivLu().solve(Y.transpose()).transpose();
+}
+
+/** The SVD based solution of (S'*S + I)^{-1} * S' * H used before. */
+Eigen::MatrixXd reference_exact_inversion(const Eigen::MatrixXd &W0,
+                                          const Eigen::MatrixXd &S,
+                                          const Eigen::MatrixXd &H,
+                                          double ies_steplength) {
+    int ens_size = S.cols();
+    Eigen::MatrixXd StS =
+        Eigen::MatrixXd::Identity(ens_size, ens_size) + S.transpose() * S;
+    auto svd = StS.bdcSvd(Eigen::ComputeFullU);
+    Eigen::MatrixXd Z = svd.matrixU();
+    Eigen::VectorXd eig = svd.singularValues();
+    Eigen::MatrixXd ZtStH = Z.transpose() * S.transpose() * H;
+    for (int i = 0; i < ens_size; i++)
+        ZtStH.row(i) /= eig[i];
+    return ies_steplength * Z * ZtStH + (1.0 - ies_steplength) * W0;
+}
+
+double relative_error(const Eigen::MatrixXd &result,
+                      const Eigen::MatrixXd &expected) {
+    return (result - expected).norm() / expected.norm();
+}
+} // namespace
+
+TEST_CASE("ies solvers agree with the previous implementation",
+          "[analysis]") {
+    const int obs_size = GENERATE(20, 200);
+    const int ens_size = 100;
+    const double tolerance = 1e-10;
+
+    Eigen::MatrixXd S = Eigen::MatrixXd::Random(obs_size, ens_size);
+    Eigen::MatrixXd H = Eigen::MatrixXd::Random(obs_size, ens_size);
+    Eigen::MatrixXd W0 = 0.1 * Eigen::MatrixXd::Random(ens_size, ens_size);
+
+    SECTION("linalg_solve_S") {
+        Eigen::MatrixXd result = ies::linalg_solve_S(W0, S);
+        REQUIRE(relative_error(result, reference_solve_S(W0, S)) < tolerance);
+    }
+
+    SECTION("linalg_solve_S in the first iteration") {
+        Eigen::MatrixXd zero = Eigen::MatrixXd::Zero(ens_size, ens_size);
+        REQUIRE(ies::linalg_solve_S(zero, S) == S);
+        REQUIRE(relative_error(S, reference_solve_S(zero, S)) < tolerance);
+    }
+
+    SECTION("linalg_exact_inversion") {
+        const double steplength = 0.6;
+        Eigen::MatrixXd expected =
+            reference_exact_inversion(W0, S, H, steplength);
+        Eigen::MatrixXd W = W0;
+        ies::linalg_exact_inversion(W, ies::IES_INVERSION_EXACT, S, H,
+                                    steplength);
+        REQUIRE(relative_error(W, expected) < tolerance);
+    }
+}
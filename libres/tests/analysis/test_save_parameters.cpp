@@ -2,6 +2,7 @@
 #include <fstream>
 #include <iostream>
 #include <optional>
+#include <set>
 
 #include "catch2/catch.hpp"
 
@@ -30,6 +31,11 @@ void save_parameters(enkf_fs_type *target_fs,
                      const std::vector<int> &iens_active_index,
                      const std::vector<Parameter> &parameters,
                      const Eigen::MatrixXd &A);
+void update_parameters(enkf_fs_type *target_fs,
+                       ensemble_config_type *ensemble_config,
+                       const std::vector<int> &iens_active_index,
+                       const std::vector<Parameter> &parameters,
+                       const Eigen::MatrixXd &X, int block_size);
 void save_row_scaling_parameters(
     enkf_fs_type *target_fs, ensemble_config_type *ensemble_config,
     const std::vector<int> &iens_active_index,
@@ -189,3 +195,157 @@ TEST_CASE("Reading and writing matrices with rowscaling attached",
         enkf_fs_decref(fs);
     }
 }
+
+TEST_CASE("Update parameters in row blocks", "[analysis][private]") {
+    GIVEN("Two parameters stored in an enkf_fs instance") {
+        WITH_TMPDIR;
+        auto file_path = std::filesystem::current_path();
+        auto fs =
+            enkf_fs_create_fs(file_path.c_str(), BLOCK_FS_DRIVER_ID, true);
+
+        auto ensemble_config = ensemble_config_alloc_full("name-not-important");
+        int ensemble_size = 10;
+        std::ofstream templatefile("template");
+        templatefile << "{\n\"a\": <COEFF_A>,\n\"b\": <COEFF_B>\n}"
+                     << std::endl;
+        templatefile.close();
+
+        std::ofstream paramfile("param");
+        paramfile << "COEFF_A UNIFORM 0 1" << std::endl;
+        paramfile << "COEFF_B UNIFORM 0 1" << std::endl;
+        paramfile.close();
+
+        std::vector<analysis::Parameter> parameters;
+        for (const char *key : {"TEST1", "TEST2"}) {
+            auto config_node =
+                ensemble_config_add_gen_kw(ensemble_config, key, false);
+            enkf_config_node_update_gen_kw(config_node, "not_important.txt",
+                                           "template", "param", nullptr,
+                                           nullptr);
+            enkf_node_type *node = enkf_node_alloc(config_node);
+            for (int i = 0; i < ensemble_size; i++)
+                enkf_node_store(node, fs, {.report_step = 0, .iens = i});
+            enkf_node_free(node);
+            parameters.emplace_back(key);
+        }
+
+        std::vector<int> active_index;
+        for (int i = 0; i < ensemble_size; i++)
+            active_index.push_back(i);
+
+        Eigen::MatrixXd A = Eigen::MatrixXd::Random(4, ensemble_size);
+        analysis::save_parameters(fs, ensemble_config, active_index, parameters,
+                                  A);
+
+        const int block_size = GENERATE(1, 2, 3, 100);
+        WHEN("Updating the parameters in blocks of " +
+             std::to_string(block_size) + " rows") {
+            Eigen::MatrixXd X =
+                Eigen::MatrixXd::Random(ensemble_size, ensemble_size);
+            analysis::update_parameters(fs, ensemble_config, active_index,
+                                        parameters, X, block_size);
+
+            THEN("The stored parameters equal A * X") {
+                auto B = analysis::load_parameters(fs, ensemble_config,
+                                                   active_index, parameters);
+                REQUIRE(B.has_value());
+                REQUIRE(B.value().isApprox(A * X));
+            }
+        }
+
+        ensemble_config_free(ensemble_config);
+        enkf_fs_decref(fs);
+    }
+}
+
+TEST_CASE("Save and load parameters of a sparse set of realizations",
+          "[analysis][private]") {
+    GIVEN("A GEN_KW parameter stored for all the realizations") {
+        WITH_TMPDIR;
+        auto file_path = std::filesystem::current_path();
+        auto fs =
+            enkf_fs_create_fs(file_path.c_str(), BLOCK_FS_DRIVER_ID, true);
+
+        auto ensemble_config = ensemble_config_alloc_full("name-not-important");
+        auto config_node =
+            ensemble_config_add_gen_kw(ensemble_config, "TEST", false);
+        std::ofstream("template") << "{\"a\": <COEFF_A>, \"b\": <COEFF_B>}";
+        std::ofstream("param") << "COEFF_A UNIFORM 0 1\n"
+                               << "COEFF_B UNIFORM 0 1\n";
+        enkf_config_node_update_gen_kw(config_node, "not_important.txt",
+                                       "template", "param", nullptr, nullptr);
+
+        const int ensemble_size = 80;
+        enkf_node_type *node = enkf_node_alloc(config_node);
+        for (int iens = 0; iens < ensemble_size; iens++)
+            enkf_node_store(node, fs, {.report_step = 0, .iens = iens});
+        enkf_node_free(node);
+
+        // Realizations 1 and 33 and 5 and 37 share a shard, the others are
+        // alone in theirs.
+        const std::vector<int> active_index{1, 4, 5, 33, 37, 38, 64, 77};
+        const std::vector<int> inactive_index{0, 2, 6, 32, 36, 79};
+        std::set<int> shards;
+        for (int iens : active_index)
+            shards.insert(enkf_fs_get_parameter_shard(fs, iens));
+        REQUIRE(shards.size() > 1);
+        REQUIRE(shards.size() < active_index.size());
+
+        std::vector<analysis::Parameter> parameters{
+            analysis::Parameter("TEST")};
+        auto inactive_before = analysis::load_parameters(
+            fs, ensemble_config, inactive_index, parameters);
+        REQUIRE(inactive_before.has_value());
+
+        Eigen::MatrixXd A(2, active_index.size());
+        for (int row = 0; row < A.rows(); row++)
+            for (int column = 0; column < A.cols(); column++)
+                A(row, column) = row + 1 + column / 10.0;
+
+        WHEN("all the rows of the parameter are saved") {
+            analysis::save_parameters(fs, ensemble_config, active_index,
+                                      parameters, A);
+
+            THEN("the parameters of the active realizations round-trip") {
+                auto B = analysis::load_parameters(fs, ensemble_config,
+                                                   active_index, parameters);
+                REQUIRE(B.has_value());
+                REQUIRE(A == B.value());
+            }
+
+            THEN("the inactive realizations are untouched") {
+                auto B = analysis::load_parameters(fs, ensemble_config,
+                                                   inactive_index, parameters);
+                REQUIRE(B.value() == inactive_before.value());
+            }
+
+            THEN("only the active realizations are initialized") {
+                auto state_map = enkf_fs_get_state_map(fs);
+                for (int iens : active_index)
+                    REQUIRE(state_map_iget(state_map, iens) ==
+                            STATE_INITIALIZED);
+                for (int iens : inactive_index)
+                    REQUIRE(state_map_iget(state_map, iens) ==
+                            STATE_UNDEFINED);
+            }
+
+            AND_WHEN("one row of the parameter is saved") {
+                std::vector<analysis::Parameter> partial{
+                    analysis::Parameter("TEST", {1})};
+                Eigen::MatrixXd A_row = -A.bottomRows(1);
+                analysis::save_parameters(fs, ensemble_config, active_index,
+                                          partial, A_row);
+
+                THEN("the other row keeps its stored value") {
+                    auto B = analysis::load_parameters(
+                        fs, ensemble_config, active_index, parameters);
+                    REQUIRE(B.value().row(0) == A.row(0));
+                    REQUIRE(B.value().row(1) == A_row.row(0));
+                }
+            }
+        }
+
+        ensemble_config_free(ensemble_config);
+        enkf_fs_decref(fs);
+    }
+}
@@ -23,6 +23,8 @@
 
 namespace analysis {
 
+Eigen::MatrixXd generate_normal_noise(int rows, int columns, uint64_t seed);
+
 void run_analysis_update_with_rowscaling(
     const ies::Config &module_config, ies::Data &module_data,
     const Eigen::MatrixXd &S, const Eigen::MatrixXd &E,
@@ -481,3 +483,21 @@ SCENARIO("Running analysis update with and without row scaling on linear model",
         meas_data_free(meas_data);
     }
 }
+
+TEST_CASE("generate_normal_noise", "[analysis]") {
+    const int rows = 1001;
+    Eigen::MatrixXd noise = analysis::generate_normal_noise(rows, 200, 42);
+
+    SECTION("The noise is standard normal") {
+        double mean = noise.mean();
+        double var = (noise.array() - mean).square().mean();
+        REQUIRE(std::abs(mean) < 0.01);
+        REQUIRE(std::abs(var - 1.0) < 0.01);
+    }
+
+    SECTION("Every column is given by the seed and the column index") {
+        Eigen::MatrixXd narrow = analysis::generate_normal_noise(rows, 3, 42);
+        REQUIRE(narrow == noise.leftCols(3));
+        REQUIRE(analysis::generate_normal_noise(rows, 3, 43) != narrow);
+    }
+}
@@ -1,8 +1,15 @@
+#include <cstdio>
 #include <filesystem>
 #include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "catch2/catch.hpp"
 
+#include <ert/util/util.h>
+
+#include <ert/enkf/block_fs_driver.hpp>
 #include <ert/enkf/enkf_fs.hpp>
 #include <ert/enkf/enkf_obs.hpp>
 
@@ -20,6 +27,17 @@ void misfit_ensemble_initialize(misfit_ensemble_type *misfit_ensemble,
 void enkf_fs_init_path_fmt(enkf_fs_type *fs);
 void enkf_fs_set_read_only(enkf_fs_type *fs, bool read_only);
 
+namespace {
+std::string read_string(block_fs_type *bfs, const char *key) {
+    auto buf = buffer_alloc(100);
+    block_fs_fread_realloc_buffer(bfs, key, buf);
+    std::string data(static_cast<const char *>(buffer_get_data(buf)),
+                     buffer_get_size(buf));
+    buffer_free(buf);
+    return data;
+}
+} // namespace
+
 TEST_CASE("enkf_fs_fwrite_misfit", "[enkf_fs]") {
     GIVEN("An instance of enkf_fs") {
         WITH_TMPDIR;
@@ -79,6 +97,32 @@ TEST_CASE("block_fs", "[enkf_fs]") {
                 REQUIRE(!block_fs_has_file(bfs, "BAR"));
             }
 
+            AND_THEN("data can be read from the memory mapped view of the "
+                     "same instance") {
+                const void *data;
+                size_t size;
+                REQUIRE(block_fs_fread_view(bfs, "FOO", &data, &size));
+                REQUIRE(random.size() == size);
+                REQUIRE(std::memcmp(random.data(), data, size) == 0);
+
+                AND_WHEN("the data file grows past the mapping") {
+                    const std::string more(100000, 'x');
+                    block_fs_fwrite_file(bfs, "BAR", more.data(), more.size());
+
+                    THEN("the new data can be read from a view, and the old "
+                         "view is still valid") {
+                        const void *bar_data;
+                        size_t bar_size;
+                        REQUIRE(block_fs_fread_view(bfs, "BAR", &bar_data,
+                                                    &bar_size));
+                        REQUIRE(bar_size == more.size());
+                        REQUIRE(std::memcmp(more.data(), bar_data, bar_size) ==
+                                0);
+                        REQUIRE(std::memcmp(random.data(), data, size) == 0);
+                    }
+                }
+            }
+
             AND_THEN("data can be read from the same instance") {
                 auto buf = buffer_alloc(100);
                 block_fs_fread_realloc_buffer(bfs, "FOO", buf);
@@ -116,6 +160,14 @@ TEST_CASE("block_fs", "[enkf_fs]") {
                                         random.size()) == 0);
                     buffer_free(buf);
                 }
+
+                AND_THEN("data can be read from the memory mapped view") {
+                    const void *data;
+                    size_t size;
+                    REQUIRE(block_fs_fread_view(bfs, "FOO", &data, &size));
+                    REQUIRE(random.size() == size);
+                    REQUIRE(std::memcmp(random.data(), data, size) == 0);
+                }
             }
         }
 
@@ -154,3 +206,317 @@ TEST_CASE("block_fs", "[enkf_fs]") {
         block_fs_close(bfs);
     }
 }
+
+TEST_CASE("block_fs index file", "[enkf_fs]") {
+    const int block_size = 64;
+    const int fsync_interval = 10;
+    const std::string expect = "foo";
+
+    GIVEN("A read-write instance of block_fs which has been closed") {
+        WITH_TMPDIR;
+        auto bfs = block_fs_mount("bfs", block_size, fsync_interval,
+                                  false /* read-only */);
+        block_fs_fwrite_file(bfs, "FOO", expect.data(), expect.size());
+        block_fs_fwrite_file(bfs, "BAR", expect.data(), expect.size());
+        block_fs_close(bfs);
+
+        THEN("the index file has been written") {
+            REQUIRE(std::filesystem::exists("bfs.index"));
+        }
+
+        WHEN("block_fs is opened read-only") {
+            bfs = block_fs_mount("bfs", block_size, fsync_interval,
+                                 true /* read-only */);
+
+            THEN("data can be read using the index file") {
+                REQUIRE(read_string(bfs, "FOO") == expect);
+                REQUIRE(read_string(bfs, "BAR") == expect);
+                REQUIRE(!block_fs_has_file(bfs, "BAZ"));
+                REQUIRE(std::filesystem::exists("bfs.index"));
+            }
+            block_fs_close(bfs);
+        }
+
+        WHEN("block_fs is opened read-write") {
+            bfs = block_fs_mount("bfs", block_size, fsync_interval,
+                                 false /* read-only */);
+
+            THEN("the index file is removed until the instance is closed") {
+                REQUIRE(!std::filesystem::exists("bfs.index"));
+                block_fs_close(bfs);
+                REQUIRE(std::filesystem::exists("bfs.index"));
+            }
+        }
+
+        WHEN("the index file is corrupt") {
+            {
+                std::fstream s{"bfs.index", std::ios::binary | std::ios::in |
+                                                std::ios::out};
+                s.seekg(16);
+                char c = s.get();
+                s.seekp(16);
+                s.put(~c);
+            }
+            bfs = block_fs_mount("bfs", block_size, fsync_interval,
+                                 true /* read-only */);
+
+            THEN("the index is built from the data file") {
+                REQUIRE(read_string(bfs, "FOO") == expect);
+                REQUIRE(read_string(bfs, "BAR") == expect);
+            }
+            block_fs_close(bfs);
+        }
+
+        WHEN("the index file is older than the data file") {
+            std::filesystem::copy_file("bfs.index", "bfs.index.old");
+
+            bfs = block_fs_mount("bfs", block_size, fsync_interval,
+                                 false /* read-only */);
+            block_fs_fwrite_file(bfs, "BAZ", expect.data(), expect.size());
+            block_fs_close(bfs);
+            std::filesystem::rename("bfs.index.old", "bfs.index");
+
+            bfs = block_fs_mount("bfs", block_size, fsync_interval,
+                                 true /* read-only */);
+            THEN("the stale index file is ignored") {
+                REQUIRE(read_string(bfs, "FOO") == expect);
+                REQUIRE(read_string(bfs, "BAZ") == expect);
+            }
+            block_fs_close(bfs);
+        }
+    }
+}
+
+TEST_CASE("block_fs concurrent writes", "[enkf_fs]") {
+    const int block_size = 64;
+    const int fsync_interval = 10;
+    const int num_threads = 8;
+    const int num_files = 50;
+
+    auto key = [](int thread, int file) {
+        return "T" + std::to_string(thread) + ".F" + std::to_string(file);
+    };
+    auto content = [](int thread, int file) {
+        return std::string(thread * 100 + file, 'a' + thread);
+    };
+
+    GIVEN("A read-write instance of block_fs") {
+        WITH_TMPDIR;
+        auto bfs = block_fs_mount("bfs", block_size, fsync_interval,
+                                  false /* read-only */);
+
+        WHEN("several threads write to it at the same time") {
+            std::vector<std::thread> threads;
+            for (int t = 0; t < num_threads; t++)
+                threads.emplace_back([&, t] {
+                    for (int f = 0; f < num_files; f++) {
+                        auto data = content(t, f);
+                        block_fs_fwrite_file(bfs, key(t, f).c_str(),
+                                             data.data(), data.size());
+                    }
+                });
+            for (auto &thread : threads)
+                thread.join();
+
+            THEN("all the data can be read back after a remount") {
+                block_fs_close(bfs);
+                bfs = block_fs_mount("bfs", block_size, fsync_interval,
+                                     false /* read-only */);
+
+                auto buf = buffer_alloc(100);
+                for (int t = 0; t < num_threads; t++)
+                    for (int f = 0; f < num_files; f++) {
+                        auto expect = content(t, f);
+                        block_fs_fread_realloc_buffer(bfs, key(t, f).c_str(),
+                                                      buf);
+                        REQUIRE(buffer_get_size(buf) == expect.size());
+                        REQUIRE(std::memcmp(buffer_get_data(buf),
+                                            expect.data(), expect.size()) == 0);
+                    }
+                buffer_free(buf);
+            }
+        }
+        block_fs_close(bfs);
+    }
+}
+
+TEST_CASE("block_fs batch write", "[enkf_fs]") {
+    const int block_size = 64;
+    const int fsync_interval = 10;
+
+    GIVEN("A read-write instance of block_fs") {
+        WITH_TMPDIR;
+        auto bfs = block_fs_mount("bfs", block_size, fsync_interval,
+                                  false /* read-only */);
+        block_fs_fwrite_file(bfs, "FOO", "single", 6);
+
+        WHEN("a batch of nodes is written") {
+            std::vector<block_fs_batch_node> nodes;
+            for (int i = 0; i < 10; i++)
+                nodes.push_back({"KEY" + std::to_string(i),
+                                 std::vector<char>(i * 37, 'a' + i)});
+            nodes.push_back({"FOO", {'b', 'a', 't', 'c', 'h'}});
+            block_fs_fwrite_batch(bfs, nodes, true);
+
+            THEN("the nodes can be read from the same instance") {
+                REQUIRE(read_string(bfs, "FOO") == "batch");
+                REQUIRE(read_string(bfs, "KEY9") == std::string(9 * 37, 'j'));
+            }
+
+            AND_WHEN("the data file is scanned at the next mount") {
+                block_fs_close(bfs);
+                std::filesystem::remove("bfs.index");
+                bfs = block_fs_mount("bfs", block_size, fsync_interval,
+                                     true /* read-only */);
+
+                THEN("all the nodes are found") {
+                    for (int i = 0; i < 10; i++) {
+                        auto key = "KEY" + std::to_string(i);
+                        REQUIRE(read_string(bfs, key.c_str()) ==
+                                std::string(i * 37, 'a' + i));
+                    }
+                    REQUIRE(read_string(bfs, "FOO") == "batch");
+                }
+            }
+        }
+        block_fs_close(bfs);
+    }
+}
+
+TEST_CASE("block_fs_driver durability", "[enkf_fs]") {
+    const int num_writes = 20;
+
+    auto write_nodes = [](ert::block_fs_driver *driver) {
+        auto buffer = buffer_alloc(100);
+        buffer_fwrite_int(buffer, 42);
+        for (int i = 0; i < num_writes; i++)
+            driver->save_node("KEY", i, 0, buffer);
+        buffer_free(buffer);
+    };
+    auto write_batch = [](ert::block_fs_driver *driver) {
+        auto buffer = buffer_alloc(100);
+        buffer_fwrite_int(buffer, 42);
+        ert::block_fs_driver::write_batch batch;
+        for (int i = 0; i < num_writes; i++)
+            driver->save_node(batch, "BATCH", i, 0, buffer);
+        driver->commit(batch);
+        buffer_free(buffer);
+    };
+    auto write_suspended = [&write_nodes](ert::block_fs_driver *driver) {
+        driver->suspend_fsync();
+        write_nodes(driver);
+        driver->resume_fsync();
+    };
+
+    GIVEN("A read-write block_fs_driver") {
+        WITH_TMPDIR;
+        auto stream = std::tmpfile();
+        block_fs_driver_create_fs(stream, ".", DRIVER_DYNAMIC_FORECAST, 1,
+                                  "mod_%d", "FORECAST");
+        std::rewind(stream);
+        REQUIRE(util_fread_int(stream) == DRIVER_DYNAMIC_FORECAST);
+        auto driver = ert::block_fs_driver::open(stream, ".", false);
+        std::fclose(stream);
+        const int fsync_count = driver->get_fsync_count();
+
+        WHEN("the durability is BFS_DURABILITY_WRITE") {
+            driver->set_durability(BFS_DURABILITY_WRITE);
+
+            THEN("every 10th write is fsync()'ed") {
+                write_nodes(driver);
+                REQUIRE(driver->get_fsync_count() ==
+                        fsync_count + num_writes / 10);
+            }
+
+            THEN("a batch is fsync()'ed once") {
+                write_batch(driver);
+                REQUIRE(driver->get_fsync_count() == fsync_count + 1);
+            }
+
+            THEN("suspended writes are fsync()'ed once on resume") {
+                write_suspended(driver);
+                REQUIRE(driver->get_fsync_count() == fsync_count + 1);
+            }
+        }
+
+        WHEN("the durability is BFS_DURABILITY_BATCH") {
+            driver->set_durability(BFS_DURABILITY_BATCH);
+
+            THEN("single writes are not fsync()'ed") {
+                write_nodes(driver);
+                REQUIRE(driver->get_fsync_count() == fsync_count);
+            }
+
+            THEN("a batch is fsync()'ed once") {
+                write_batch(driver);
+                REQUIRE(driver->get_fsync_count() == fsync_count + 1);
+            }
+        }
+
+        WHEN("the durability is BFS_DURABILITY_UMOUNT") {
+            driver->set_durability(BFS_DURABILITY_UMOUNT);
+
+            THEN("neither single writes nor batches are fsync()'ed") {
+                write_nodes(driver);
+                write_batch(driver);
+                REQUIRE(driver->get_fsync_count() == fsync_count);
+            }
+
+            THEN("suspended writes are not fsync()'ed on resume") {
+                write_suspended(driver);
+                REQUIRE(driver->get_fsync_count() == fsync_count);
+            }
+        }
+        delete driver;
+    }
+}
+
+TEST_CASE("block_fs compaction", "[enkf_fs]") {
+    const int block_size = 64;
+    const int fsync_interval = 10;
+
+    GIVEN("A read-write instance of block_fs where nodes are overwritten") {
+        WITH_TMPDIR;
+        auto bfs = block_fs_mount("bfs", block_size, fsync_interval,
+                                  false /* read-only */);
+        const std::string expect(1000, 'x');
+        for (int i = 0; i < 10; i++) {
+            std::string data(1000, 'a' + i);
+            block_fs_fwrite_file(bfs, "FOO", data.data(), data.size());
+        }
+        block_fs_fwrite_file(bfs, "BAR", expect.data(), expect.size());
+        auto size_before = std::filesystem::file_size("bfs.data_0");
+
+        WHEN("the data file is compacted") {
+            long reclaimed = block_fs_compact(bfs);
+            auto size_after = std::filesystem::file_size("bfs.data_0");
+
+            THEN("the space of the overwritten nodes is reclaimed") {
+                REQUIRE(reclaimed > 0);
+                REQUIRE(size_after == size_before - reclaimed);
+                REQUIRE(!std::filesystem::exists("bfs.data_0.compact"));
+            }
+
+            THEN("the live nodes can still be read and written") {
+                REQUIRE(read_string(bfs, "FOO") == std::string(1000, 'j'));
+                REQUIRE(read_string(bfs, "BAR") == expect);
+
+                block_fs_fwrite_file(bfs, "BAZ", expect.data(), expect.size());
+                REQUIRE(read_string(bfs, "BAZ") == expect);
+            }
+
+            AND_WHEN("the data file is scanned at the next mount") {
+                block_fs_close(bfs);
+                std::filesystem::remove("bfs.index");
+                bfs = block_fs_mount("bfs", block_size, fsync_interval,
+                                     true /* read-only */);
+
+                THEN("the live nodes are found") {
+                    REQUIRE(read_string(bfs, "FOO") == std::string(1000, 'j'));
+                    REQUIRE(read_string(bfs, "BAR") == expect);
+                }
+            }
+        }
+        block_fs_close(bfs);
+    }
+}
@@ -0,0 +1,103 @@
+#include <cmath>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include <ert/enkf/field_codec.hpp>
+
+namespace {
+std::vector<float> make_field(size_t size) {
+    std::vector<float> data(size);
+    for (size_t i = 0; i < size; i++)
+        data[i] = 100 + std::sin(0.01 * i);
+    return data;
+}
+} // namespace
+
+TEST_CASE("field_codec round trip", "[enkf]") {
+    const auto data = make_field(10007);
+    const size_t byte_size = data.size() * sizeof(float);
+    auto codec = GENERATE(FIELD_CODEC_NONE, FIELD_CODEC_LZ4, FIELD_CODEC_ZLIB);
+    auto shuffle = GENERATE(false, true);
+
+    buffer_type *buffer = buffer_alloc(100);
+    buffer_fwrite_int(buffer, 77);
+    field_codec_fwrite(buffer, data.data(), byte_size, sizeof(float), codec,
+                       shuffle);
+    buffer_rewind(buffer);
+    REQUIRE(buffer_fread_int(buffer) == 77);
+
+    std::vector<float> copy(data.size());
+    field_codec_fread(buffer, copy.data(), byte_size);
+    REQUIRE(copy == data);
+    REQUIRE(buffer_get_remaining_size(buffer) == 0);
+    buffer_free(buffer);
+}
+
+TEST_CASE("field_codec shuffles partial elements", "[enkf]") {
+    const std::vector<char> data = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+
+    buffer_type *buffer = buffer_alloc(100);
+    field_codec_fwrite(buffer, data.data(), data.size(), 4, FIELD_CODEC_NONE,
+                       true);
+    buffer_rewind(buffer);
+
+    std::vector<char> copy(data.size());
+    field_codec_fread(buffer, copy.data(), copy.size());
+    REQUIRE(copy == data);
+    buffer_free(buffer);
+}
+
+TEST_CASE("field_codec reads zlib data without a codec header", "[enkf]") {
+    const auto data = make_field(1000);
+    const size_t byte_size = data.size() * sizeof(float);
+
+    buffer_type *buffer = buffer_alloc(100);
+    buffer_fwrite_compressed(buffer, data.data(), byte_size);
+    buffer_rewind(buffer);
+
+    std::vector<float> copy(data.size());
+    field_codec_fread(buffer, copy.data(), byte_size);
+    REQUIRE(copy == data);
+    buffer_free(buffer);
+}
+
+TEST_CASE("field_codec names", "[enkf]") {
+    for (auto codec : {FIELD_CODEC_NONE, FIELD_CODEC_LZ4, FIELD_CODEC_ZLIB}) {
+        field_codec_enum parsed;
+        REQUIRE(field_codec_from_string(field_codec_to_string(codec), &parsed));
+        REQUIRE(parsed == codec);
+    }
+    field_codec_enum parsed;
+    REQUIRE_FALSE(field_codec_from_string("BZIP2", &parsed));
+}
+
+TEST_CASE("field_codec decodes single chunks", "[enkf]") {
+    const auto data = make_field(3 * FIELD_CODEC_CHUNK_SIZE / sizeof(float) +
+                                 17);
+    const size_t byte_size = data.size() * sizeof(float);
+    auto codec = GENERATE(FIELD_CODEC_NONE, FIELD_CODEC_LZ4, FIELD_CODEC_ZLIB);
+
+    buffer_type *buffer = buffer_alloc(100);
+    field_codec_fwrite(buffer, data.data(), byte_size, sizeof(float), codec,
+                       true);
+    const char *record = (const char *)buffer_get_data(buffer);
+
+    field_codec_layout layout;
+    REQUIRE(field_codec_fread_header(record, &layout));
+    REQUIRE(layout.num_chunks() == 4);
+    field_codec_fread_chunk_index(record + FIELD_CODEC_HEADER_SIZE, &layout);
+    REQUIRE(layout.chunk_offsets.back() == buffer_get_size(buffer));
+
+    // Only the last chunk is decoded, the rest of the field is untouched.
+    const int chunk = 3;
+    std::vector<float> copy(data.size(), -1);
+    field_codec_decode_chunk(layout, chunk,
+                             record + layout.chunk_offsets[chunk], copy.data(),
+                             byte_size);
+
+    const size_t first = chunk * layout.chunk_size / sizeof(float);
+    for (size_t i = 0; i < data.size(); i++)
+        REQUIRE(copy[i] == (i < first ? -1 : data[i]));
+    buffer_free(buffer);
+}
@@ -0,0 +1,112 @@
+#include <signal.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include <ert/enkf/gen_common.hpp>
+
+#include "../tmpdir.hpp"
+
+namespace {
+/**
+   Runs gen_common_fscanf_alloc() on file in a child process, which is
+   expected to abort, and returns what the child wrote to stderr.
+*/
+std::string fscanf_alloc_abort_message(const char *file,
+                                       ecl_data_type data_type) {
+    int fd[2];
+    REQUIRE(pipe(fd) == 0);
+    pid_t pid = fork();
+    REQUIRE(pid >= 0);
+    if (pid == 0) {
+        close(fd[0]);
+        dup2(fd[1], STDERR_FILENO);
+        signal(SIGABRT, SIG_DFL);
+        // Write the abort message to stderr rather than to a dump file
+        setenv("ERT_SHOW_BACKTRACE", "1", 1);
+        int size;
+        gen_common_fscanf_alloc(file, data_type, &size);
+        _exit(0);
+    }
+
+    close(fd[1]);
+    std::string message;
+    char buffer[256];
+    ssize_t read_size;
+    while ((read_size = read(fd[0], buffer, sizeof buffer)) > 0)
+        message.append(buffer, read_size);
+    close(fd[0]);
+
+    int status;
+    REQUIRE(waitpid(pid, &status, 0) == pid);
+    REQUIRE(WIFSIGNALED(status));
+    REQUIRE(WTERMSIG(status) == SIGABRT);
+    return message;
+}
+} // namespace
+
+TEST_CASE("gen_common_fscanf_alloc", "[enkf]") {
+    WITH_TMPDIR;
+    {
+        std::ofstream stream("data.txt");
+        stream << "1.5 +2\n-3e2\t4\n\n  5  \n";
+    }
+
+    SECTION("Loads doubles") {
+        int size = 0;
+        auto *data =
+            (double *)gen_common_fscanf_alloc("data.txt", ECL_DOUBLE, &size);
+        REQUIRE(std::vector<double>(data, data + size) ==
+                std::vector<double>{1.5, 2, -300, 4, 5});
+        free(data);
+    }
+
+    SECTION("Loads floats") {
+        int size = 0;
+        auto *data =
+            (float *)gen_common_fscanf_alloc("data.txt", ECL_FLOAT, &size);
+        REQUIRE(std::vector<float>(data, data + size) ==
+                std::vector<float>{1.5, 2, -300, 4, 5});
+        free(data);
+    }
+
+    SECTION("Loads an empty file") {
+        std::ofstream("empty.txt") << "\n \n";
+        int size = 10;
+        auto *data =
+            (int *)gen_common_fscanf_alloc("empty.txt", ECL_INT, &size);
+        REQUIRE(size == 0);
+        free(data);
+    }
+
+    SECTION("Aborts with the position of a trailing non-number") {
+        std::ofstream("invalid.txt") << "1 2\n  3 4,5\n";
+        for (auto data_type : {ECL_DOUBLE, ECL_FLOAT, ECL_INT}) {
+            std::string message =
+                fscanf_alloc_abort_message("invalid.txt", data_type);
+            REQUIRE_THAT(message, Catch::Matchers::Contains(
+                                      "invalid.txt terminated before EOF was "
+                                      "reached at line 2 column 6"));
+        }
+    }
+}
+
+TEST_CASE("gen_common_fscanf_int_vector", "[enkf]") {
+    WITH_TMPDIR;
+    std::ofstream("active.txt") << "1 0\n1 1 0 1";
+
+    REQUIRE(gen_common_fscanf_int_vector("active.txt", 4) ==
+            std::vector<int>{1, 0, 1, 1});
+    REQUIRE(gen_common_fscanf_int_vector("active.txt", 100) ==
+            std::vector<int>{1, 0, 1, 1, 0, 1});
+
+    std::ofstream("invalid.txt") << "1 0 X 1";
+    REQUIRE(gen_common_fscanf_int_vector("invalid.txt", 4) ==
+            std::vector<int>{1, 0});
+}
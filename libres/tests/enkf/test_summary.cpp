@@ -0,0 +1,82 @@
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include <ert/ecl/ecl_sum.hpp>
+
+#include <ert/enkf/summary.hpp>
+
+namespace {
+/**
+  Creates an ecl_sum instance with the keys FOPR and FGPR, with two ministeps
+  for each of the report steps 1 ... num_reports.
+*/
+ecl_sum_type *alloc_ecl_sum(int num_reports) {
+    ecl_sum_type *ecl_sum =
+        ecl_sum_alloc_writer("CASE", false, true, ":", 0, true, 10, 10, 10);
+    const ecl::smspec_node *fopr =
+        ecl_sum_add_var(ecl_sum, "FOPR", NULL, 0, "SM3/DAY", 0);
+    const ecl::smspec_node *fgpr =
+        ecl_sum_add_var(ecl_sum, "FGPR", NULL, 0, "SM3/DAY", 0);
+
+    int ministep = 0;
+    for (int report_step = 1; report_step <= num_reports; report_step++) {
+        for (int i = 0; i < 2; i++) {
+            ecl_sum_tstep_type *tstep =
+                ecl_sum_add_tstep(ecl_sum, report_step, 86400.0 * ministep);
+            ecl_sum_tstep_set_from_node(tstep, *fopr, ministep);
+            ecl_sum_tstep_set_from_node(tstep, *fgpr, 100 + ministep);
+            ministep++;
+        }
+    }
+    return ecl_sum;
+}
+} // namespace
+
+TEST_CASE("summary_load_plan", "[enkf]") {
+    const int num_reports = 4;
+    ecl_sum_type *ecl_sum = alloc_ecl_sum(num_reports);
+
+    // The first stored step is not loaded, and the last stored step is not
+    // in the ecl_sum instance.
+    int_vector_type *time_index = int_vector_alloc(0, -1);
+    int_vector_iset(time_index, 0, -1);
+    for (int step = 1; step <= num_reports + 1; step++)
+        int_vector_iset(time_index, step, step);
+
+    const summary_load_plan plan = summary_alloc_load_plan(ecl_sum, time_index);
+    REQUIRE(plan.store_index == std::vector<int>{1, 2, 3, 4});
+    for (size_t i = 0; i < plan.store_index.size(); i++)
+        REQUIRE(plan.ministep[i] ==
+                ecl_sum_iget_report_end(ecl_sum, plan.store_index[i]));
+
+    GIVEN("Columns with existing data") {
+        std::vector<int> params_index = {
+            ecl_sum_get_general_var_params_index(ecl_sum, "FGPR"),
+            ecl_sum_get_general_var_params_index(ecl_sum, "FOPR")};
+        std::vector<std::vector<double>> columns = {
+            {-1, -1, -1, -1, -1, -1, -1}, {-1}};
+
+        summary_load_plan_gather(plan, ecl_sum, params_index, columns);
+
+        THEN("The planned steps are loaded and the other steps are kept") {
+            REQUIRE(columns[0].size() == 7);
+            REQUIRE(columns[1].size() == 5);
+            REQUIRE(columns[0][0] == -1);
+            REQUIRE(columns[0][5] == -1);
+            REQUIRE(columns[0][6] == -1);
+            REQUIRE(columns[1][0] == -1);
+            for (size_t i = 0; i < plan.store_index.size(); i++) {
+                int store_index = plan.store_index[i];
+                REQUIRE(columns[0][store_index] ==
+                        ecl_sum_get_general_var(ecl_sum, plan.ministep[i],
+                                                "FGPR"));
+                REQUIRE(columns[1][store_index] ==
+                        ecl_sum_get_general_var(ecl_sum, plan.ministep[i],
+                                                "FOPR"));
+            }
+        }
+    }
+    int_vector_free(time_index);
+    ecl_sum_free(ecl_sum);
+}
@@ -0,0 +1,49 @@
+#include "catch2/catch.hpp"
+
+#include <ert/ecl/ecl_sum.hpp>
+
+#include <ert/enkf/summary_key_matcher.hpp>
+
+TEST_CASE("summary_key_matcher_match_smspec", "[enkf]") {
+    ecl_sum_type *ecl_sum =
+        ecl_sum_alloc_writer("CASE", false, true, ":", 0, true, 10, 10, 10);
+    ecl_sum_add_var(ecl_sum, "FOPR", NULL, 0, "SM3/DAY", 0);
+    ecl_sum_add_var(ecl_sum, "WOPR", "OP_1", 0, "SM3/DAY", 0);
+    ecl_sum_add_var(ecl_sum, "WGPR", "OP_1", 0, "SM3/DAY", 0);
+    ecl_sum_add_var(ecl_sum, "FGPR", NULL, 0, "SM3/DAY", 0);
+    const ecl_smspec_type *smspec = ecl_sum_get_smspec(ecl_sum);
+
+    summary_key_matcher_type *matcher = summary_key_matcher_alloc();
+    summary_key_matcher_add_summary_key(matcher, "FOPR");
+    summary_key_matcher_add_summary_key(matcher, "W?PR:*");
+
+    auto selection = summary_key_matcher_match_smspec(matcher, smspec);
+    REQUIRE(selection->size() == ecl_smspec_num_nodes(smspec));
+    for (int i = 0; i < ecl_smspec_num_nodes(smspec); i++) {
+        const char *key =
+            ecl_smspec_iget_node_w_node_index(smspec, i).get_gen_key1();
+        REQUIRE((*selection)[i] ==
+                summary_key_matcher_match_summary_key(matcher, key));
+    }
+
+    THEN("The selection is reused for the same layout") {
+        REQUIRE(summary_key_matcher_match_smspec(matcher, smspec) ==
+                selection);
+    }
+
+    THEN("Adding a key invalidates the selection") {
+        summary_key_matcher_add_summary_key(matcher, "FGPR");
+        auto updated = summary_key_matcher_match_smspec(matcher, smspec);
+        REQUIRE(updated != selection);
+        for (int i = 0; i < ecl_smspec_num_nodes(smspec); i++) {
+            const char *key =
+                ecl_smspec_iget_node_w_node_index(smspec, i).get_gen_key1();
+            REQUIRE((*updated)[i] ==
+                    summary_key_matcher_match_summary_key(matcher, key));
+        }
+        REQUIRE(summary_key_matcher_match_summary_key(matcher, "FGPR"));
+    }
+
+    summary_key_matcher_free(matcher);
+    ecl_sum_free(ecl_sum);
+}
@@ -0,0 +1,125 @@
+#include <string.h>
+
+#include <filesystem>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include <ert/enkf/enkf_fs.hpp>
+#include <ert/enkf/summary_table.hpp>
+
+#include "../tmpdir.hpp"
+
+TEST_CASE("summary_table round trip", "[enkf_fs]") {
+    ert::summary_table table;
+    table.set_column("FOPR", {1.0, 2.0, 3.0});
+    table.set_column("FGPR", {10.0});
+    table.set_column("FWPR", {});
+    table.set_column("FOPR", {1.5, 2.5, 3.5, 4.5});
+
+    REQUIRE(table.size() == 3);
+
+    buffer_type *buffer = buffer_alloc(100);
+    table.fwrite(buffer);
+    buffer_fwrite_int(buffer, 77);
+    buffer_rewind(buffer);
+
+    auto copy = ert::summary_table::fread(buffer);
+    REQUIRE(copy.size() == 3);
+    REQUIRE(copy.get_column("FOPR") ==
+            std::vector<double>{1.5, 2.5, 3.5, 4.5});
+    REQUIRE(copy.get_column("FGPR") == std::vector<double>{10.0});
+    REQUIRE(copy.get_column("FWPR").empty());
+    REQUIRE_FALSE(copy.has_column("FLPR"));
+    // The reader leaves the buffer positioned after the table
+    REQUIRE(buffer_fread_int(buffer) == 77);
+
+    const char *data = (const char *)buffer_get_data(buffer);
+    auto directory = ert::summary_table::fread_directory(
+        data, data + ert::summary_table::header_size);
+    auto expected = table.get_directory();
+    REQUIRE(directory.num_steps == 4);
+    REQUIRE(directory.data_offset == expected.data_offset);
+
+    for (const auto &[key, col] : expected.columns) {
+        const auto &found = directory.columns.at(key);
+        REQUIRE(found.index == col.index);
+        REQUIRE(found.length == col.length);
+
+        std::vector<double> slice(col.length);
+        memcpy(slice.data(), data + directory.column_offset(found),
+               slice.size() * sizeof(double));
+        REQUIRE(slice == table.get_column(key));
+    }
+    buffer_free(buffer);
+}
+
+TEST_CASE("summary_table rejects invalid records", "[enkf_fs]") {
+    buffer_type *buffer = buffer_alloc(100);
+    ert::summary_table table;
+    table.set_column("FOPR", {1.0, 2.0, 3.0});
+    table.fwrite(buffer);
+
+    SECTION("Invalid magic") {
+        int magic = 0;
+        memcpy(buffer_get_data(buffer), &magic, sizeof magic);
+        buffer_rewind(buffer);
+        REQUIRE_THROWS(ert::summary_table::fread(buffer));
+    }
+
+    SECTION("Truncated data") {
+        buffer_type *truncated = buffer_alloc(100);
+        buffer_fwrite(truncated, buffer_get_data(buffer), 1,
+                      buffer_get_size(buffer) - sizeof(double));
+        buffer_rewind(truncated);
+        REQUIRE_THROWS(ert::summary_table::fread(truncated));
+        buffer_free(truncated);
+    }
+    buffer_free(buffer);
+}
+
+TEST_CASE("summary_table in enkf_fs", "[enkf_fs]") {
+    GIVEN("A mounted enkf_fs") {
+        WITH_TMPDIR;
+        auto mount_point = std::filesystem::current_path() / "fs";
+        auto fs = enkf_fs_create_fs(mount_point.c_str(), BLOCK_FS_DRIVER_ID,
+                                    true);
+        const int iens = 3;
+
+        THEN("No table is stored initially") {
+            REQUIRE(enkf_fs_fread_summary_table(fs, iens).size() == 0);
+            REQUIRE_FALSE(
+                enkf_fs_has_vector(fs, "FOPR", DYNAMIC_RESULT, iens));
+        }
+
+        WHEN("A table is written") {
+            ert::summary_table table;
+            table.set_column("FOPR", {1.0, 2.0, 3.0});
+            table.set_column("FGPR", {4.0, 5.0});
+            enkf_fs_fwrite_summary_table(fs, table, iens);
+
+            THEN("Single vectors can be read back") {
+                std::vector<double> data;
+                REQUIRE(enkf_fs_fread_summary_vector(fs, "FGPR", iens, data));
+                REQUIRE(data == std::vector<double>{4.0, 5.0});
+                REQUIRE(enkf_fs_has_vector(fs, "FOPR", DYNAMIC_RESULT, iens));
+                REQUIRE_FALSE(
+                    enkf_fs_fread_summary_vector(fs, "FWPR", iens, data));
+                REQUIRE_FALSE(
+                    enkf_fs_fread_summary_vector(fs, "FOPR", iens + 1, data));
+            }
+
+            THEN("Rewriting the table replaces the cached directory") {
+                table.set_column("FOPR", {7.0, 8.0, 9.0, 10.0});
+                enkf_fs_fwrite_summary_table(fs, table, iens);
+
+                std::vector<double> data;
+                REQUIRE(enkf_fs_fread_summary_vector(fs, "FOPR", iens, data));
+                REQUIRE(data == std::vector<double>{7.0, 8.0, 9.0, 10.0});
+                REQUIRE(enkf_fs_fread_summary_vector(fs, "FGPR", iens, data));
+                REQUIRE(data == std::vector<double>{4.0, 5.0});
+            }
+        }
+        enkf_fs_decref(fs);
+    }
+}
@@ -0,0 +1,106 @@
+#include <chrono>
+#include <thread>
+
+#include "catch2/catch.hpp"
+
+#include <ert/job_queue/local_driver.hpp>
+
+namespace {
+/** Waits until the job has left the given statuses, and returns the new one. */
+job_status_type wait_while(void *driver, void *job, int statuses) {
+    auto end = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while ((local_driver_get_job_status(driver, job) & statuses) &&
+           std::chrono::steady_clock::now() < end)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    return local_driver_get_job_status(driver, job);
+}
+
+void *submit(void *driver, const char *command, int num_cpu = 1) {
+    const char *argv[] = {"-c", command};
+    return local_driver_submit_job(driver, "/bin/sh", num_cpu, ".", "job", 2,
+                                   argv);
+}
+} // namespace
+
+TEST_CASE("local_driver runs jobs", "[job_queue]") {
+    void *driver = local_driver_alloc();
+
+    void *ok_job = submit(driver, "exit 0");
+    void *failing_job = submit(driver, "exit 1");
+    REQUIRE(wait_while(driver, ok_job, JOB_QUEUE_PENDING | JOB_QUEUE_RUNNING) ==
+            JOB_QUEUE_DONE);
+    REQUIRE(wait_while(driver, failing_job,
+                       JOB_QUEUE_PENDING | JOB_QUEUE_RUNNING) ==
+            JOB_QUEUE_EXIT);
+
+    void *killed_job = submit(driver, "sleep 60");
+    wait_while(driver, killed_job, JOB_QUEUE_PENDING);
+    local_driver_kill_job(driver, killed_job);
+    REQUIRE(wait_while(driver, killed_job, JOB_QUEUE_RUNNING) ==
+            JOB_QUEUE_EXIT);
+
+    local_driver_free_job(ok_job);
+    local_driver_free_job(failing_job);
+    local_driver_free_job(killed_job);
+    local_driver_free__(driver);
+}
+
+TEST_CASE("local_driver schedules jobs on MAX_CORES", "[job_queue]") {
+    void *driver = local_driver_alloc();
+    REQUIRE(local_driver_set_option(driver, LOCAL_MAX_CORES, "2"));
+
+    void *wide_job = submit(driver, "sleep 60", 2);
+    REQUIRE(wait_while(driver, wide_job, JOB_QUEUE_PENDING) ==
+            JOB_QUEUE_RUNNING);
+
+    // There are no free cores until the first job is done
+    void *job = submit(driver, "exit 0");
+    void *pending_job = submit(driver, "exit 0");
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    REQUIRE(local_driver_get_job_status(driver, job) == JOB_QUEUE_PENDING);
+
+    local_driver_kill_job(driver, pending_job);
+    REQUIRE(local_driver_get_job_status(driver, pending_job) ==
+            JOB_QUEUE_IS_KILLED);
+    local_driver_kill_job(driver, wide_job);
+    REQUIRE(wait_while(driver, job, JOB_QUEUE_PENDING) != JOB_QUEUE_PENDING);
+
+    local_driver_free_job(wide_job);
+    local_driver_free_job(job);
+    local_driver_free_job(pending_job);
+    local_driver_free__(driver);
+}
+
+TEST_CASE("local_driver runs jobs needing more than MAX_CORES alone",
+          "[job_queue]") {
+    void *driver = local_driver_alloc();
+    REQUIRE(local_driver_set_option(driver, LOCAL_MAX_CORES, "3"));
+
+    void *wide_job = submit(driver, "sleep 60", 2);
+    REQUIRE(wait_while(driver, wide_job, JOB_QUEUE_PENDING) ==
+            JOB_QUEUE_RUNNING);
+
+    void *huge_job = submit(driver, "sleep 60", 4);
+    void *job = submit(driver, "exit 0");
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    REQUIRE(local_driver_get_job_status(driver, wide_job) == JOB_QUEUE_RUNNING);
+    REQUIRE(local_driver_get_job_status(driver, huge_job) == JOB_QUEUE_PENDING);
+    REQUIRE(local_driver_get_job_status(driver, job) == JOB_QUEUE_PENDING);
+
+    local_driver_kill_job(driver, wide_job);
+    REQUIRE(wait_while(driver, huge_job, JOB_QUEUE_PENDING) ==
+            JOB_QUEUE_RUNNING);
+    REQUIRE(local_driver_get_job_status(driver, wide_job) == JOB_QUEUE_EXIT);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    REQUIRE(local_driver_get_job_status(driver, huge_job) == JOB_QUEUE_RUNNING);
+    REQUIRE(local_driver_get_job_status(driver, job) == JOB_QUEUE_PENDING);
+
+    local_driver_kill_job(driver, huge_job);
+    REQUIRE(wait_while(driver, job, JOB_QUEUE_PENDING | JOB_QUEUE_RUNNING) ==
+            JOB_QUEUE_DONE);
+
+    local_driver_free_job(wide_job);
+    local_driver_free_job(huge_job);
+    local_driver_free_job(job);
+    local_driver_free__(driver);
+}
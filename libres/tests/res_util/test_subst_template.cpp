@@ -0,0 +1,170 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include <ert/res_util/subst_func.hpp>
+#include <ert/res_util/subst_list.hpp>
+#include <ert/res_util/subst_template.hpp>
+
+#include "../tmpdir.hpp"
+
+namespace {
+/** The result of the sequential substitution in subst_list_update_string(). */
+std::string
+update_string(const std::string &text,
+              const std::vector<const subst_list_type *> &subst_lists) {
+    char *buffer = strdup(text.c_str());
+    for (const auto *subst_list : subst_lists) {
+        if (subst_list)
+            subst_list_update_string(subst_list, &buffer);
+    }
+    std::string result = buffer;
+    free(buffer);
+    return result;
+}
+
+void require_same_result(
+    const std::string &text,
+    const std::vector<const subst_list_type *> &subst_lists) {
+    const ert::subst_template tmpl(text);
+    std::string result;
+    tmpl.instantiate(subst_lists, result);
+    REQUIRE(result == update_string(text, subst_lists));
+
+    // The second instantiation reuses the compiled plan
+    tmpl.instantiate(subst_lists, result);
+    REQUIRE(result == update_string(text, subst_lists));
+}
+} // namespace
+
+TEST_CASE("subst_template gives the same result as subst_list",
+          "[res_util]") {
+    subst_func_pool_type *func_pool = subst_func_pool_alloc();
+    subst_func_pool_add_func(func_pool, "ADD", "Adds arguments",
+                             subst_func_add, true, 1, 0, NULL);
+    subst_list_type *parent = subst_list_alloc(func_pool);
+    subst_list_insert_func(parent, "ADD", "__ADD__");
+    subst_list_append_copy(parent, "<CASE>", "Test4", NULL);
+    subst_list_append_copy(parent, "<IENS>", "0", NULL);
+    subst_list_type *subst_list = subst_list_alloc(parent);
+    subst_list_append_copy(subst_list, "<IENS>", "7", NULL);
+    subst_list_append_copy(subst_list, "<ITER>", "2", NULL);
+
+    SECTION("Plain substitution") {
+        std::string text = "<CASE>/real-<IENS>/iter-<ITER> <UNKNOWN> <ITER>";
+        ert::subst_template tmpl(text);
+        std::string result;
+        REQUIRE(tmpl.instantiate({subst_list}, result));
+        REQUIRE(result == "Test4/real-0/iter-2 <UNKNOWN> 2");
+        require_same_result(text, {subst_list});
+
+        ert::subst_template no_keys("No keys here");
+        REQUIRE_FALSE(no_keys.instantiate({subst_list}, result));
+        REQUIRE(result == "No keys here");
+    }
+
+    SECTION("Cascading substitutions") {
+        subst_list_append_copy(subst_list, "<PATH>", "/tmp/run/<CASE>", NULL);
+        subst_list_append_copy(subst_list, "<FIRST>", "<SECOND>", NULL);
+        subst_list_append_copy(subst_list, "<SECOND>", "second", NULL);
+        require_same_result("<PATH> <FIRST> <SECOND>", {subst_list});
+    }
+
+    SECTION("Values completing a key") {
+        subst_list_append_copy(subst_list, "<LT>", "<", NULL);
+        subst_list_append_copy(subst_list, "<EMPTY>", "", NULL);
+        require_same_result("<LT>ITER> <<EMPTY>ITER>", {subst_list});
+    }
+
+    SECTION("Overlapping keys") {
+        subst_list_append_copy(subst_list, "ITER>", "iter", NULL);
+        require_same_result("<ITER> ITER>", {subst_list});
+    }
+
+    SECTION("Function calls") {
+        require_same_result("__ADD__(<ITER>, 1) <IENS>", {subst_list});
+    }
+
+    SECTION("Several subst_lists") {
+        subst_list_type *template_args = subst_list_alloc(parent);
+        subst_list_append_copy(template_args, "<ARG>", "<ITER>", NULL);
+        subst_list_append_copy(template_args, "<CASE>", "Test5", NULL);
+        require_same_result("<ARG> <CASE> <IENS>",
+                            {template_args, subst_list});
+        require_same_result("<ARG> <CASE> <IENS>", {template_args, NULL});
+        subst_list_free(template_args);
+    }
+
+    subst_list_free(subst_list);
+    subst_list_free(parent);
+    subst_func_pool_free(func_pool);
+}
+
+TEST_CASE("subst_template files are cached", "[res_util]") {
+    WITH_TMPDIR;
+    std::filesystem::path path = "template.txt";
+    std::ofstream{path} << "<IENS>";
+
+    auto file_template = ert::subst_template::load(path);
+    REQUIRE(file_template->text() == "<IENS>");
+    REQUIRE(ert::subst_template::load(path) == file_template);
+    REQUIRE(ert::subst_template::load(std::filesystem::absolute(path)) ==
+            file_template);
+
+    SECTION("A file with a new size is read again") {
+        std::ofstream{path} << "<IENS> <ITER>";
+        auto updated = ert::subst_template::load(path);
+        REQUIRE(updated != file_template);
+        REQUIRE(updated->text() == "<IENS> <ITER>");
+        REQUIRE(ert::subst_template::load(path) == updated);
+    }
+
+    SECTION("A file with a new modification time is read again") {
+        std::ofstream{path} << "<ITER>";
+        std::filesystem::last_write_time(
+            path, std::filesystem::last_write_time(path) +
+                      std::chrono::seconds(10));
+        auto updated = ert::subst_template::load(path);
+        REQUIRE(updated->text() == "<ITER>");
+    }
+}
+
+TEST_CASE("subst_template file cache is shared between threads",
+          "[res_util]") {
+    WITH_TMPDIR;
+    const int num_files = 4;
+    for (int i = 0; i < num_files; i++)
+        std::ofstream{"template" + std::to_string(i)} << "<IENS> " << i;
+
+    std::vector<std::shared_ptr<const ert::subst_template>> templates(
+        4 * num_files);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < templates.size(); i++)
+        threads.emplace_back([&templates, i] {
+            templates[i] = ert::subst_template::load(
+                "template" + std::to_string(i % num_files));
+        });
+    for (auto &thread : threads)
+        thread.join();
+
+    for (size_t i = 0; i < templates.size(); i++) {
+        REQUIRE(templates[i] == templates[i % num_files]);
+        REQUIRE(templates[i]->text() ==
+                "<IENS> " + std::to_string(i % num_files));
+    }
+
+    SECTION("A cleared cache reads the files again") {
+        ert::subst_template::clear_cache();
+        auto file_template = ert::subst_template::load("template0");
+        REQUIRE(file_template != templates[0]);
+        REQUIRE(file_template->text() == templates[0]->text());
+    }
+}
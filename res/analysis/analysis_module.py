@@ -73,6 +73,10 @@ class AnalysisModule(BaseCClass):
             "step": 0.01,
             "labelname": "Singular value truncation",
         },
+        "IES_A0_ON_DISK": {
+            "type": bool,
+            "labelname": "Store initial ensemble on disk",
+        },
     }
 
     def __init__(self, type_id):
@@ -39,6 +39,7 @@ from .enkf_simulation_runner import EnkfSimulationRunner
 from .ensemble_config import EnsembleConfig
 from .enums import (
     ActiveMode,
+    BfsDurability,
     EnkfFieldFileFormatEnum,
     EnKFFSType,
     EnkfInitModeEnum,
@@ -123,6 +124,7 @@ __all__ = [
     "EnKFFSType",
     "GenDataFileType",
     "ActiveMode",
+    "BfsDurability",
     "HookRuntime",
     "AnalysisIterConfig",
     "AnalysisConfig",
@@ -92,6 +92,12 @@ class AnalysisConfig(BaseCClass):
     _set_std_cutoff = ResPrototype(
         "void analysis_config_set_std_cutoff(analysis_config, double)"
     )
+    _get_update_block_size = ResPrototype(
+        "int analysis_config_get_update_block_size(analysis_config)"
+    )
+    _set_update_block_size = ResPrototype(
+        "void analysis_config_set_update_block_size(analysis_config, int)"
+    )
     _set_global_std_scaling = ResPrototype(
         "void analysis_config_set_global_std_scaling(analysis_config, double)"
     )
@@ -219,6 +225,12 @@ class AnalysisConfig(BaseCClass):
     def setStdCutoff(self, std_cutoff):
         self._set_std_cutoff(std_cutoff)
 
+    def get_update_block_size(self) -> int:
+        return self._get_update_block_size()
+
+    def set_update_block_size(self, block_size: int):
+        self._set_update_block_size(block_size)
+
     def getAnalysisIterConfig(self) -> AnalysisIterConfig:
         """@rtype: AnalysisIterConfig"""
         return self._get_iter_config().setParent(self)
@@ -298,6 +310,9 @@ class AnalysisConfig(BaseCClass):
         if self.getEnkfAlpha() != other.getEnkfAlpha():
             return False
 
+        if self.get_update_block_size() != other.get_update_block_size():
+            return False
+
         if self.get_rerun() != other.get_rerun():
             return False
 
@@ -16,7 +16,7 @@
 from cwrap import BaseCClass
 
 from res import ResPrototype
-from res.enkf.enums import EnKFFSType
+from res.enkf.enums import BfsDurability, EnKFFSType
 from res.enkf.state_map import StateMap
 from res.enkf.summary_key_set import SummaryKeySet
 from res.enkf.util import TimeMap
@@ -36,9 +36,15 @@ class EnkfFs(BaseCClass):
     _incref = ResPrototype("int   enkf_fs_incref(enkf_fs)")
     _get_refcount = ResPrototype("int   enkf_fs_get_refcount(enkf_fs)")
     _get_case_name = ResPrototype("char* enkf_fs_get_case_name(enkf_fs)")
+    _get_mount_point = ResPrototype("char* enkf_fs_get_mount_point(enkf_fs)")
     _is_read_only = ResPrototype("bool  enkf_fs_is_read_only(enkf_fs)")
     _is_running = ResPrototype("bool  enkf_fs_is_running(enkf_fs)")
     _fsync = ResPrototype("void  enkf_fs_fsync(enkf_fs)")
+    _compact = ResPrototype("long  enkf_fs_compact(enkf_fs)")
+    _migrate_summary = ResPrototype("int   enkf_fs_migrate_summary(enkf_fs)")
+    _set_durability = ResPrototype(
+        "void  enkf_fs_set_durability(enkf_fs, bfs_durability_enum)"
+    )
     _create = ResPrototype(
         "enkf_fs_obj   enkf_fs_create_fs(char* , enkf_fs_type_enum , bool)",
         bind=False,
@@ -79,6 +85,9 @@ class EnkfFs(BaseCClass):
         """@rtype: str"""
         return self._get_case_name()
 
+    def getMountPoint(self) -> str:
+        return self._get_mount_point()
+
     def isReadOnly(self):
         """@rtype: bool"""
         return self._is_read_only()
@@ -141,6 +150,27 @@ class EnkfFs(BaseCClass):
     def fsync(self):
         self._fsync()
 
+    def compact(self) -> int:
+        """Rewrites the storage with only the live data, and returns the
+        number of bytes reclaimed. The filesystem must not be in use by any
+        running simulations while it is compacted."""
+        return self._compact()
+
+    def migrate_summary(self) -> int:
+        """Converts summary data stored with one record per summary key to
+        one summary table per realization, and returns the number of
+        realizations which were migrated."""
+        return self._migrate_summary()
+
+    def set_durability(self, durability: BfsDurability):
+        """Sets when the data written to the storage is fsync()'ed: for every
+        10th write (the default), once per batch of writes, or only when
+        the filesystem is unmounted. Has no effect on a read-only
+        filesystem."""
+        if not isinstance(durability, BfsDurability):
+            raise TypeError(f"Expected BfsDurability, got {durability!r}")
+        self._set_durability(durability)
+
     def getSummaryKeySet(self) -> SummaryKeySet:
         """@rtype: SummaryKeySet"""
         return self._summary_key_set().setParent(self)
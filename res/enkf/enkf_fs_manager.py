@@ -121,6 +121,7 @@ class EnkfFsManager(BaseCClass):
 
         self._fs_rotator = FileSystemRotator(capacity)
         self._mount_root = real_enkf_main.getMountPoint()
+        self._durability = real_enkf_main.getModelConfig().getStorageDurability()
 
     def _createFullCaseName(self, mount_root: str, case_name: str) -> str:
         return os.path.join(mount_root, case_name)
@@ -142,6 +143,7 @@ class EnkfFsManager(BaseCClass):
                 EnkfFs.createFileSystem(full_case_name)
 
             new_fs = EnkfFs(full_case_name)
+            new_fs.set_durability(self._durability)
             self._fs_rotator.addFileSystem(new_fs, full_case_name)
 
         fs = self._fs_rotator[full_case_name]
@@ -10,6 +10,7 @@ from .enkf_truncation_type import EnkfTruncationType
 from .enkf_fs_type_enum import EnKFFSType
 from .gen_data_file_type_enum import GenDataFileType
 from .active_mode_enum import ActiveMode
+from .bfs_durability_enum import BfsDurability
 from .hook_runtime_enum import HookRuntime
 
 __all__ = [
@@ -25,5 +26,6 @@ __all__ = [
     "EnKFFSType",
     "GenDataFileType",
     "ActiveMode",
+    "BfsDurability",
     "HookRuntime",
 ]
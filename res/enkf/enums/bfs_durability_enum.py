@@ -0,0 +1,28 @@
+#  Copyright (C) 2026  Equinor ASA, Norway.
+#
+#  The file 'bfs_durability_enum.py' is part of ERT - Ensemble based Reservoir Tool.
+#
+#  ERT is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or
+#  (at your option) any later version.
+#
+#  ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+#  WARRANTY; without even the implied warranty of MERCHANTABILITY or
+#  FITNESS FOR A PARTICULAR PURPOSE.
+#
+#  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+#  for more details.
+from cwrap import BaseCEnum
+
+
+class BfsDurability(BaseCEnum):
+    TYPE_NAME = "bfs_durability_enum"
+    BFS_DURABILITY_WRITE = None
+    BFS_DURABILITY_BATCH = None
+    BFS_DURABILITY_UMOUNT = None
+
+
+BfsDurability.addEnum("BFS_DURABILITY_WRITE", 0)
+BfsDurability.addEnum("BFS_DURABILITY_BATCH", 1)
+BfsDurability.addEnum("BFS_DURABILITY_UMOUNT", 2)
@@ -50,12 +50,22 @@ def analysis_ES(
     ensemble_config: EnsembleConfig,
     source_fs: EnkfFs,
     target_fs: EnkfFs,
+    update_block_size: int = 0,
 ) -> None:
 
     iens_active_index = [i for i in range(len(ens_mask)) if ens_mask[i]]
 
     update.copy_parameters(source_fs, target_fs, ensemble_config, ens_mask)
 
+    # The initial ensemble is stored by the first update step of the first
+    # iteration, so the A0 file is only set once, before any of them.
+    if (
+        module_config.A0_on_disk
+        and w_container.iteration_nr == 1
+        and not w_container.has_A0_file()
+    ):
+        w_container.set_A0_file(str(Path(source_fs.getMountPoint()) / "ies_A0"))
+
     # Looping over local analysis update_step
     for update_step in updatestep:
 
@@ -79,9 +89,23 @@ def analysis_ES(
                 f"No active observations for update step: {update_step.name}."
             )
 
-        A = update.load_parameters(
-            target_fs, ensemble_config, iens_active_index, update_step.parameters
-        )
+        # With an update block size the parameters are updated block by block
+        # by update.update_parameters(). The transition matrix X only depends
+        # on A when the state size is smaller than the ensemble size, those
+        # (small) updates are done with the full A matrix.
+        stream_parameters = False
+        if update_block_size > 0:
+            state_size = update.parameter_state_size(
+                target_fs, ensemble_config, update_step.parameters
+            )
+            stream_parameters = state_size > max(
+                update_block_size, len(iens_active_index) - 1
+            )
+        A = None
+        if not stream_parameters:
+            A = update.load_parameters(
+                target_fs, ensemble_config, iens_active_index, update_step.parameters
+            )
         A_with_rowscaling = update.load_row_scaling_parameters(
             target_fs,
             ensemble_config,
@@ -96,7 +120,25 @@ def analysis_ES(
         E = (E.T / observation_errors).T
         S = (S.T / observation_errors).T
 
-        if A is not None:
+        if stream_parameters:
+            X = ies.make_X(
+                S,
+                R,
+                E,
+                D,
+                np.zeros((0, len(iens_active_index))),
+                ies_inversion=module_config.inversion,
+                truncation=module_config.get_truncation(),
+            )
+            update.update_parameters(
+                target_fs,
+                ensemble_config,
+                iens_active_index,
+                update_step.parameters,
+                X,
+                update_block_size,
+            )
+        elif A is not None:
             X = ies.make_X(
                 S,
                 R,
@@ -127,7 +169,7 @@ def analysis_ES(
                     ies_inversion=module_config.inversion,
                     truncation=module_config.get_truncation(),
                 )
-                row_scaling.multiply(A, X)
+                row_scaling.multiply_direct(A, X)
 
             update.save_row_scaling_parameters(
                 target_fs,
@@ -322,6 +364,7 @@ class ESUpdate:
             ensemble_config,
             source_fs,
             target_fs,
+            analysis_config.get_update_block_size(),
         )
 
         _write_update_report(
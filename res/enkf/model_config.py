@@ -19,6 +19,7 @@ from cwrap import BaseCClass
 from ecl.summary import EclSum
 from res import ResPrototype
 from res.enkf.config_keys import ConfigKeys
+from res.enkf.enums import BfsDurability
 from res.enkf.util import TimeMap
 from res.job_queue import ForwardModel
 from res.sched import HistorySourceEnum
@@ -66,6 +67,12 @@ class ModelConfig(BaseCClass):
     )
     _set_runpath = ResPrototype("void  model_config_set_runpath(model_config, char*)")
     _get_enspath = ResPrototype("char* model_config_get_enspath(model_config)")
+    _get_storage_durability = ResPrototype(
+        "bfs_durability_enum model_config_get_storage_durability(model_config)"
+    )
+    _set_storage_durability = ResPrototype(
+        "void model_config_set_storage_durability(model_config, bfs_durability_enum)"
+    )
     _get_history_source = ResPrototype(
         "history_source_enum model_config_get_history_source(model_config)"
     )
@@ -119,6 +126,7 @@ class ModelConfig(BaseCClass):
                 f"{ConfigKeys.HISTORY_SOURCE} is not supported"
             )
 
+        storage_durability = None
         if config_dict is None:
             c_ptr = self._alloc(
                 config_content, data_root, joblist, last_history_restart, refcase
@@ -145,6 +153,9 @@ class ModelConfig(BaseCClass):
             if ens_path is not None:
                 ens_path = os.path.realpath(ens_path)
 
+            # STORAGE_DURABILITY_KEY
+            storage_durability = config_dict.get(ConfigKeys.STORAGE_DURABILITY)
+
             # JOBNAME_KEY
             job_name = config_dict.get(ConfigKeys.JOBNAME)
 
@@ -216,6 +227,9 @@ class ModelConfig(BaseCClass):
 
         super().__init__(c_ptr, is_reference=is_reference)
 
+        if storage_durability is not None:
+            self._set_storage_durability(storage_durability)
+
     def hasHistory(self):
         return self._has_history()
 
@@ -277,6 +291,9 @@ class ModelConfig(BaseCClass):
         """@rtype: str"""
         return self._get_enspath()
 
+    def getStorageDurability(self) -> BfsDurability:
+        return self._get_storage_durability()
+
     def getRunpathFormat(self) -> PathFormat:
         """@rtype: PathFormat"""
         return self._get_runpath_fmt()
@@ -309,6 +326,9 @@ class ModelConfig(BaseCClass):
         if os.path.realpath(self.getEnspath()) != os.path.realpath(other.getEnspath()):
             return False
 
+        if self.getStorageDurability() != other.getStorageDurability():
+            return False
+
         if self.getRunpathFormat() != other.getRunpathFormat():
             return False
 
@@ -62,6 +62,14 @@ class AnalysisConfigTest(ResTest):
             ac.setGlobalStdScaling(0.77)
             self.assertFloatEqual(ac.getGlobalStdScaling(), 0.77)
 
+    def test_analysis_config_update_block_size(self):
+        with TestAreaContext("analysis_config_init_test") as work_area:
+            work_area.copy_directory(self.case_directory)
+            ac = AnalysisConfig(self.case_file)
+            self.assertEqual(ac.get_update_block_size(), 0)
+            ac.set_update_block_size(1000)
+            self.assertEqual(ac.get_update_block_size(), 1000)
+
     def test_init(self):
         with TestAreaContext("analysis_config_init_test") as work_area:
             work_area.copy_directory(self.case_directory)
@@ -3,7 +3,7 @@ from ecl.util.test import TestAreaContext
 from libres_utils import ResTest, tmpdir
 
 from res.enkf import EnkfFs
-from res.enkf.enums import EnKFFSType
+from res.enkf.enums import BfsDurability, EnKFFSType
 
 
 @pytest.mark.equinor_test
@@ -45,6 +45,17 @@ class EnKFFSTest(ResTest):
             new_fs = EnkfFs.createFileSystem("newFS", mount=True)
             self.assertTrue(isinstance(new_fs, EnkfFs))
 
+    @tmpdir()
+    def test_set_durability(self):
+        with TestAreaContext("set_durability"):
+            fs = EnkfFs.createFileSystem("newFS", mount=True)
+            for durability in BfsDurability.enums():
+                fs.set_durability(durability)
+
+            with self.assertRaises(TypeError):
+                fs.set_durability(1)
+            fs.umount()
+
     def test_throws(self):
         with self.assertRaises(Exception):
             EnkfFs("/does/not/exist")
@@ -3,6 +3,8 @@ from pathlib import Path
 import fileinput
 import shutil
 
+import pytest
+
 from res.enkf import ResConfig
 from res.enkf.enkf_main import EnKFMain
 
@@ -43,3 +45,25 @@ def test_without_gen_kw(copy_case):
     )
     assert len(os.listdir("storage/snake_oil/runpath")) == 1
     assert len(os.listdir("storage/snake_oil/runpath/realization-0")) == 1
+
+
+def test_failing_runpath_does_not_stop_other_realizations(copy_case):
+    copy_case("local/snake_oil")
+    shutil.rmtree("storage")
+    res_config = ResConfig("snake_oil.ert")
+    main = EnKFMain(res_config)
+    fs = main.getEnkfFsManager().getCurrentFileSystem()
+    run_context = main.getRunContextENSEMPLE_EXPERIMENT(fs, [True, True, True])
+
+    # A regular file where the runpath of realization 1 should be created
+    os.makedirs("storage/snake_oil/runpath", exist_ok=True)
+    Path("storage/snake_oil/runpath/realization-1").write_text("blocked")
+
+    with pytest.raises(RuntimeError, match=r"realization\(s\): 1$"):
+        main.getEnkfSimulationRunner().createRunPath(run_context)
+
+    for iens in (0, 2):
+        assert os.path.exists(
+            f"storage/snake_oil/runpath/realization-{iens}/iter-0/parameters.txt"
+        )
+    assert os.path.isfile("storage/snake_oil/runpath/realization-1")
@@ -13,10 +13,12 @@
 #
 #  See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
 #  for more details.
+import pytest
 from ecl.util.test import TestAreaContext
 from libres_utils import ResTest
 
 from res.enkf import ConfigKeys, ModelConfig, ResConfig
+from res.enkf.enums import BfsDurability
 from res.sched import HistorySourceEnum
 
 
@@ -171,3 +173,20 @@ class ModelConfigTest(ResTest):
                 f"{ConfigKeys.HISTORY_SOURCE} is not supported"
             )
             self.assertIn(expected, str(cm.exception))
+
+
+@pytest.mark.usefixtures("use_tmpdir")
+@pytest.mark.parametrize(
+    "config_line, durability",
+    [
+        ("", BfsDurability.BFS_DURABILITY_WRITE),
+        ("STORAGE_DURABILITY WRITE", BfsDurability.BFS_DURABILITY_WRITE),
+        ("STORAGE_DURABILITY BATCH", BfsDurability.BFS_DURABILITY_BATCH),
+        ("STORAGE_DURABILITY UMOUNT", BfsDurability.BFS_DURABILITY_UMOUNT),
+    ],
+)
+def test_storage_durability(config_line, durability):
+    with open("config_file.ert", "w") as fout:
+        fout.write(f"NUM_REALIZATIONS 1\n{config_line}\n")
+    res_config = ResConfig("config_file.ert")
+    assert res_config.model_config.getStorageDurability() == durability
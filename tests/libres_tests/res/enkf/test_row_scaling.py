@@ -115,3 +115,10 @@ def test_field_config():
         assert row_scaling[g] == row_scaling.clamp(
             gaussian_decay(obs_pos, length_scale, grid, g)
         )
+
+
+def test_no_clamp():
+    row_scaling = RowScaling(clamp=False)
+    row_scaling[0] = 0.123456789
+    assert row_scaling[0] == 0.123456789
+    assert row_scaling.clamp(0.123456789) == 0.123456789
@@ -27,3 +27,21 @@ class SummaryKeyMatcherTest(ResTest):
         self.assertTrue(matcher.isRequired("FOPT"))
         self.assertFalse(matcher.isRequired("FGIR"))
         self.assertFalse(matcher.isRequired("TCPU"))
+
+    def test_patterns(self):
+        matcher = SummaryKeyMatcher()
+        matcher.addSummaryKey("WOPR:*")
+        matcher.addSummaryKey("W?PR:OP_1")
+        matcher.addSummaryKey("*:INJ")
+        matcher.addSummaryKey("[AB]PR")
+
+        self.assertTrue("WOPR:OP_2" in matcher)
+        self.assertTrue("WGPR:OP_1" in matcher)
+        self.assertTrue("WWIR:INJ" in matcher)
+        self.assertTrue("BPR" in matcher)
+        self.assertFalse("WGPR:OP_2" in matcher)
+        self.assertFalse("WOPT:OP_1" in matcher)
+        self.assertFalse("CPR" in matcher)
+
+        matcher.addSummaryKey("WOPT:OP_1")
+        self.assertTrue("WOPT:OP_1" in matcher)